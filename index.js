@@ -30,9 +30,16 @@ async function demo(context) {
             buffer_2.data(usage, new Float32Array(1, 3, 5));
             
             console.log("Val_0: " + usage.value());
-            while(!esc_pressed){
-                await context.run();
-            }
+            await new Promise((stopped) => {
+                context.onFrameAdd("cond", (index, dt) => {
+                    if (esc_pressed){
+                        context.stop();
+                        stopped();
+                    }
+                    return !esc_pressed;
+                });
+                context.start();
+            });
             console.log("Val_1: " + usage.value());
         }
         resolve(true);
@@ -1,128 +1,669 @@
 #include "native/Context.hpp"
 
+#include <cstring>
+
 #include <glad/gl.h>
 #define GLFW_INCLUDE_NONE
 #include "GLFW/glfw3.h"
 
+#include "native/EventPump.hpp"
+#include "native/gl/Sync.hpp"
+
 using namespace nglpmt::native;
 
-std::atomic<unsigned int> Context::_glfw_windows = 0;
+thread_local const Context* Context::_current = nullptr;
 
 std::shared_ptr<Context> Context::make(const Parameters& params){
+    if (params.frames_in_flight == 0 || params.frames_in_flight > max_frames_in_flight){
+        throw std::invalid_argument("Context frames_in_flight should be from 1 to " + std::to_string(max_frames_in_flight));
+    }
     return std::shared_ptr<Context>(new Context(params));
 }
 
 Context::Context(const Parameters& params) :
     SharedObject(),
     _gl_thread(new BS::thread_pool(1)),
-    _init_time(std::chrono::steady_clock::now()),
-    _last_start_time(std::chrono::steady_clock::now()),
-    _last_finish_time(std::chrono::steady_clock::now()),
-
     onStart(decltype(onStart)::element_type::make(_gl_thread)),
     onRun(decltype(onRun)::element_type::make(_gl_thread)),
     onFinish(decltype(onFinish)::element_type::make(_gl_thread)),
-    onKey(decltype(onKey)::element_type::make(_gl_thread)){
+    onFrame(decltype(onFrame)::element_type::make(_gl_thread)),
+    onInput(decltype(onInput)::element_type::make(_gl_thread)),
+    onKey(decltype(onKey)::element_type::make(_gl_thread)),
+    _input(params.input_capacity),
+    _pump(EventPump::get()),
+    _params(params),
+    _init_time(std::chrono::steady_clock::now()),
+    _last_start_time(std::chrono::steady_clock::now()),
+    _last_finish_time(std::chrono::steady_clock::now()),
+    _frame_timer(new BS::thread_pool(1)),
+    _frame_fences(params.frames_in_flight, nullptr),
+    _timings(params.timing_frames){
 
+    // Failed initialization is rethrown from make()
     _gl_thread->submit([this, &params](){
         std::cout << "GL: " << std::this_thread::get_id() << std::endl;
-        try {
-            _initGl(params);
-        } catch (const std::exception& err){
-            std::cout << err.what() << std::endl;
+        _initGl(params);
+    }).get();
+
+    // Events are polled by EventPump
+    onStart->addActionQueued([this](){
+        if (_params.headless){
+            return true;
         }
-        
-    }).wait();
+        auto swap_start = std::chrono::steady_clock::now();
+        glfwSwapBuffers(_window.get());
+        _swap_time = std::chrono::duration_cast<us>(std::chrono::steady_clock::now() - swap_start);
+        return true;
+    });
 
-    onStart->addActionQueued([window = _window](){
-        glfwPollEvents();
-        glfwSwapBuffers(window.get());
+    onStart->addActionQueued([this](){
+        _beginFrame();
         return true;
     });
     
 }
 
 Context::~Context(){
+    // Queued frames and markers capture this, they should finish first
+    stop();
+    auto release = [this](){
+        for (auto& fence : _frame_fences){
+            if (fence){
+                glDeleteSync(fence);
+            }
+        }
+        for (auto& timer : _gpu_timers){
+            glDeleteQueries(1, &timer.query);
+        }
+        glfwMakeContextCurrent(nullptr);
+        _current = nullptr;
+    };
+    if (std::this_thread::get_id() == _gl_thread_id){
+        // Last reference was released by gl task, waiting would deadlock
+        release();
+    } else {
+        _gl_thread->wait_for_tasks();
+        _gl_thread->submit(release).wait();
+    }
+    // Their _finishFrame could not lock context anymore, waiters are
+    // released anyway
+    for (auto& [index, callbacks] : _frame_callbacks){
+        for (auto& callback : callbacks){
+            callback();
+        }
+    }
+
+    // Windows can be destroyed only when their contexts are not current
+    for (auto& loader : _loaders){
+        loader.thread->wait_for_tasks();
+        loader.thread->submit([](){
+            glfwMakeContextCurrent(nullptr);
+            _current = nullptr;
+        }).wait();
+    }
+    _loaders.clear();
+    _window.reset();
+}
+
+std::shared_future<void> Context::run(){
+    _checkNotStarted();
+    _emitFrame();
+    std::lock_guard lg(_frames_lock);
+    return _frames_finished.front().second;
+}
+
+void Context::run(const std::function<void()>& on_ready){
+    _checkNotStarted();
+    _emitFrame();
+    std::unique_lock lg(_frames_lock);
+    auto& [index, ready] = _frames_finished.front();
+    if (ready.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+        // _finishFrame of that frame takes the lock, it can not be missed
+        _frame_callbacks[index].push_back(on_ready);
+        return;
+    }
+    lg.unlock();
+    on_ready();
+}
+
+void Context::_checkNotStarted() const {
+    if (_started){
+        // Two frame streams would share slots and fences
+        throw std::logic_error("Context::run() is not allowed while scheduler is started");
+    }
+}
+
+void Context::_finishFrame(const uint64_t& index){
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard lg(_frames_lock);
+        auto iter = _frame_callbacks.find(index);
+        if (iter == _frame_callbacks.end()){
+            return;
+        }
+        callbacks = std::move(iter->second);
+        _frame_callbacks.erase(iter);
+    }
+    for (auto& callback : callbacks){
+        callback();
+    }
 }
 
-std::future<void> Context::run(){
+std::shared_future<void> Context::_emitFrame(){
     auto now = std::chrono::steady_clock::now();
     auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(now - _last_start_time);
     _last_start_time = now;
+    auto index = _frame_index++;
 
+    _markPhase(index, _Phase::Begin);
+    // Drained here rather than in an onInput action, so onKey handlers run
+    // before onStart of this frame instead of after its onFinish
+    auto batch = std::make_shared<InputBatch>();
+    _drainInput(*batch);
+    onInput->emitQueued(this->shared_from_this(), batch);
     onStart->emitQueued(this->shared_from_this(), dt);
+    _markPhase(index, _Phase::Start);
     onRun->emitQueued(this->shared_from_this(), dt);
-    return onFinish->emitQueued(this->shared_from_this(), dt);
+    _markPhase(index, _Phase::Run);
+    auto finished = onFinish->emitQueued(this->shared_from_this(), dt).share();
+    _markPhase(index, _Phase::Finish);
+    static_cast<void>(_gl_thread->submit([wself = weak_from_this(), index](){
+        auto self = wself.lock();
+        if (self){
+            self->_finishFrame(index);
+        }
+    }));
+
+    std::lock_guard lg(_frames_lock);
+    _frames_finished.emplace_back(index, finished);
+    if (_frames_finished.size() > _params.frames_in_flight){
+        _frames_finished.pop_front();
+    }
+    return finished;
+}
+
+void Context::start(){
+    if (_started.exchange(true)){
+        return;
+    }
+    auto schedule_id = ++_schedule_id;
+    static_cast<void>(_gl_thread->submit([wself = weak_from_this(), schedule_id, vsync = _params.vsync](){
+        auto self = wself.lock();
+        if (!self){
+            return;
+        }
+        glfwSwapInterval(vsync ? 1 : 0);
+        self->_next_frame_time = std::chrono::steady_clock::now();
+        self->_scheduleFrame(schedule_id);
+    }));
+}
+
+void Context::stop(){
+    _started = false;
+}
+
+bool Context::isStarted() const {
+    return _started;
+}
+
+uint64_t Context::getSkippedFrames() const {
+    return _skipped_frames;
+}
+
+unsigned int Context::getFramesInFlight() const {
+    return _params.frames_in_flight;
+}
+
+unsigned int Context::getFrameSlot() const {
+    return _frame_slot;
+}
+
+std::vector<Context::FrameTiming> Context::getFrameTimings() const {
+    std::lock_guard lg(_timings_lock);
+    std::vector<FrameTiming> timings;
+    if (_timings.empty()){
+        return timings;
+    }
+    uint64_t count = std::min<uint64_t>(_timings_written, _timings.size());
+    timings.reserve(count);
+    for (uint64_t i = _timings_written - count; i < _timings_written; ++i){
+        timings.push_back(_timings[i % _timings.size()]);
+    }
+    return timings;
 }
 
 const std::thread::id& Context::getThreadId() const {
     return _gl_thread_id;
 }
 
-void Context::_initGl(const Parameters& params){
-    _gl_thread_id = std::this_thread::get_id();
+bool Context::isContextThread() const {
+    return _current == this;
+}
 
-    if (_glfw_windows == 0 && !glfwInit()){
-        throw std::runtime_error("Failed to initialize GLFW.");
+const Context* Context::getCurrent(){
+    return _current;
+}
+
+std::future<void> Context::load(const std::function<void()>& task){
+    auto done = std::make_shared<std::promise<void>>();
+    auto result = done->get_future();
+    if (_loaders.empty()){
+        // Same context, later commands are ordered after the task anyway
+        onRun->addActionQueued([task, done](){
+            try {
+                task();
+                done->set_value();
+            } catch (...){
+                done->set_exception(std::current_exception());
+            }
+            return false;
+        });
+        return result;
     }
-    ++_glfw_windows;
 
-    std::vector<std::pair<int, int>> hints = {
-        // {GLFW_VERSION_MAJOR, 4},
-        // {GLFW_VERSION_MINOR, 6},
-        {GLFW_CONTEXT_VERSION_MAJOR, 4},
-        {GLFW_CONTEXT_VERSION_MINOR, 6},
-        {GLFW_REFRESH_RATE, params.fps},
-    };
+    auto& loader = _loaders[_next_loader++ % _loaders.size()];
+    static_cast<void>(loader.thread->submit([task, done](){
+        try {
+            task();
+            // Handoff: objects are complete once loader commands are executed
+            auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            GlSync::blockUntilSignaled(fence);
+            glDeleteSync(fence);
+            done->set_value();
+        } catch (...){
+            done->set_exception(std::current_exception());
+        }
+    }));
+    return result;
+}
+
+unsigned int Context::getLoaderThreads() const {
+    return static_cast<unsigned int>(_loaders.size());
+}
 
-    for (auto& hint : hints){
-        glfwWindowHint(hint.first, hint.second);
+bool Context::hasParallelShaderCompile() const {
+    return _parallel_shader_compile;
+}
+
+bool Context::isHeadless() const {
+    return _params.headless;
+}
+
+void Context::_scheduleFrame(const uint64_t& schedule_id){
+    if (!_started || _schedule_id != schedule_id){
+        return;
+    }
+    auto frame_time = _nextFrameTime();
+    if (frame_time <= std::chrono::steady_clock::now()){
+        _emitScheduledFrame(schedule_id);
+        return;
     }
 
-    _window = std::shared_ptr<GLFWwindow>(
-        glfwCreateWindow(params.width, params.height, params.title.c_str(), NULL, NULL),
-        [](GLFWwindow* window){
-            glfwDestroyWindow(window);
-            --_glfw_windows;
-            if (_glfw_windows == 0){
-                glfwTerminate();
+    // Timer thread holds no reference to context, last one is never
+    // released there
+    _frame_timer->push_task([wself = weak_from_this(), gl_thread = _gl_thread, frame_time, schedule_id](){
+        using clock = std::chrono::steady_clock;
+        if (frame_time - clock::now() > _spin_threshold){
+            std::this_thread::sleep_until(frame_time - _spin_threshold);
+        }
+        while (clock::now() < frame_time){
+            std::this_thread::yield();
+        }
+        gl_thread->push_task([wself, schedule_id](){
+            auto self = wself.lock();
+            if (self){
+                self->_emitScheduledFrame(schedule_id);
             }
+        });
+    });
+}
+
+void Context::_emitScheduledFrame(const uint64_t& schedule_id){
+    if (!_started || _schedule_id != schedule_id){
+        return;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    auto dt = std::chrono::duration<double, std::milli>(start_time - _last_start_time).count();
+    auto index = _frame_index.load();
+    auto finished = _emitFrame();
+    // Single gl thread runs pool tasks in order, this one follows onFinish
+    // of the frame, wait only guards that order
+    static_cast<void>(_gl_thread->submit([wself = weak_from_this(), finished, schedule_id, index, dt](){
+        finished.wait();
+        auto self = wself.lock();
+        if (!self){
+            return;
         }
-    );
-    glfwSetWindowUserPointer(_window.get(), this);
+        self->_last_finish_time = std::chrono::steady_clock::now();
+        self->onFrame->emitQueued(self, index, dt);
+        self->_scheduleFrame(schedule_id);
+    }));
+}
+
+std::chrono::steady_clock::time_point Context::_nextFrameTime(){
+    using clock = std::chrono::steady_clock;
+    auto now = clock::now();
+    if ((_params.vsync && !_params.headless) || _params.fps <= 0){
+        // Blocked by glfwSwapBuffers or not paced at all
+        return now;
+    }
+    auto period = std::chrono::duration_cast<clock::duration>(std::chrono::seconds(1)) / _params.fps;
+
+    if (now < _next_frame_time){
+        auto frame_time = _next_frame_time;
+        _next_frame_time += period;
+        return frame_time;
+    }
+
+    // Late frame starts right away
+    auto missed = (now - _next_frame_time) / period;
+    switch (_params.late_policy){
+    case LatePolicy::Skip:
+        _skipped_frames += missed;
+        _next_frame_time += missed * period;
+        break;
+    case LatePolicy::Reset:
+        _next_frame_time = now;
+        break;
+    }
+    _next_frame_time += period;
+    return now;
+}
+
+void Context::_beginFrame(){
+    // Fence after swap covers every command of previous frame
+    if (_gl_frame_index > 0){
+        _frame_fences[_frame_slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    ++_gl_frame_index;
+    _frame_slot = _gl_frame_index % _params.frames_in_flight;
+
+    auto& fence = _frame_fences[_frame_slot];
+    if (!fence){
+        return;
+    }
+    GlSync::blockUntilSignaled(fence);
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void Context::_markPhase(const uint64_t& index, const _Phase& phase){
+    // Single gl thread runs pool tasks in order, so marker is executed
+    // right after commands queued by previous emit
+    static_cast<void>(_gl_thread->submit([wself = weak_from_this(), index, phase](){
+        auto self = wself.lock();
+        if (self){
+            self->_recordPhase(index, phase);
+        }
+    }));
+}
+
+void Context::_recordPhase(const uint64_t& index, const _Phase& phase){
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<us>(now - _phase_time);
+    _phase_time = now;
+
+    switch (phase){
+    case _Phase::Begin:
+        _collectGpuTimers();
+        _frame_timing = FrameTiming{.index = index};
+        break;
+    case _Phase::Start:
+        _frame_timing.start = elapsed;
+        _frame_timing.swap = _swap_time;
+        _beginGpuTimer(index);
+        break;
+    case _Phase::Run:
+        _frame_timing.run = elapsed;
+        break;
+    case _Phase::Finish: {
+        _frame_timing.finish = elapsed;
+        _endGpuTimer();
+        std::lock_guard lg(_timings_lock);
+        if (!_timings.empty()){
+            _timings[_timings_written % _timings.size()] = _frame_timing;
+            ++_timings_written;
+        }
+        break;
+    }
+    }
+}
+
+void Context::_beginGpuTimer(const uint64_t& index){
+    if (_gpu_timers.empty()){
+        _gpu_timers.resize(_gpu_timers_count);
+        for (auto& timer : _gpu_timers){
+            glCreateQueries(GL_TIME_ELAPSED, 1, &timer.query);
+        }
+    }
+
+    auto& timer = _gpu_timers[_gpu_timer_next];
+    if (timer.pending){
+        return;
+    }
+    _gpu_timer_next = (_gpu_timer_next + 1) % _gpu_timers.size();
+    glBeginQuery(GL_TIME_ELAPSED, timer.query);
+    timer.index = index;
+    timer.pending = true;
+    _gpu_timer_active = &timer;
+}
+
+void Context::_endGpuTimer(){
+    if (!_gpu_timer_active){
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    _gpu_timer_active = nullptr;
+}
+
+void Context::_collectGpuTimers(){
+    for (auto& timer : _gpu_timers){
+        if (!timer.pending){
+            continue;
+        }
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(timer.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available){
+            continue;
+        }
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(timer.query, GL_QUERY_RESULT, &ns);
+        timer.pending = false;
+
+        std::lock_guard lg(_timings_lock);
+        for (auto& timing : _timings){
+            if (timing.index == timer.index){
+                timing.gpu = std::chrono::duration_cast<us>(std::chrono::nanoseconds(ns));
+                break;
+            }
+        }
+    }
+}
+
+void Context::_initGl(const Parameters& params){
+    _gl_thread_id = std::this_thread::get_id();
+
+    _window = _createWindow(params, nullptr, !params.headless);
+    _pump->execute([this](){
+        _initCallbacks();
+    });
     glfwMakeContextCurrent(_window.get());
+    _current = this;
     
     auto ver = gladLoadGL(glfwGetProcAddress);
     if (ver == 0){
         throw std::runtime_error("Failed to initialize OpenGL context.");
     }
     std::cout << "Version: " << ver << std::endl;
-    
-    glfwSetWindowPosCallback(_window.get(), [](GLFWwindow* window, int x, int y){
-        auto ctx = static_cast<Context*>(glfwGetWindowUserPointer(window));
-        // ctx->onWindowMove.emit(ctx, x, y);
+    _initParallelShaderCompile();
+    _initLoaders(params);
+}
+
+void Context::_initCallbacks(){
+    using Type = InputEvent::Type;
+    auto window = _window.get();
+    glfwSetWindowUserPointer(window, this);
+
+    glfwSetWindowPosCallback(window, [](GLFWwindow* window, int x, int y){
+        _pushInput(window, {.type = Type::WindowMove, .args = {x, y}});
+    });
+    glfwSetWindowSizeCallback(window, [](GLFWwindow* window, int width, int height){
+        _pushInput(window, {.type = Type::WindowResize, .args = {width, height}});
+    });
+    glfwSetWindowCloseCallback(window, [](GLFWwindow* window){
+        _pushInput(window, {.type = Type::WindowClose});
+    });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* window){
+        _pushInput(window, {.type = Type::WindowRefresh});
+    });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow* window, int focused){
+        _pushInput(window, {.type = Type::WindowFocus, .args = {focused}});
+    });
+    glfwSetWindowIconifyCallback(window, [](GLFWwindow* window, int iconified){
+        _pushInput(window, {.type = Type::WindowIconify, .args = {iconified}});
+    });
+    glfwSetWindowMaximizeCallback(window, [](GLFWwindow* window, int maximized){
+        _pushInput(window, {.type = Type::WindowMaximize, .args = {maximized}});
+    });
+    glfwSetWindowContentScaleCallback(window, [](GLFWwindow* window, float x, float y){
+        _pushInput(window, {.type = Type::WindowScale, .values = {x, y}});
+    });
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height){
+        _pushInput(window, {.type = Type::FramebufferResize, .args = {width, height}});
     });
 
-    glfwSetKeyCallback(_window.get(), [](GLFWwindow* window, int key, int scancode, int action, int mods){
+    glfwSetCursorEnterCallback(window, [](GLFWwindow* window, int entered){
+        auto ctx = static_cast<Context*>(glfwGetWindowUserPointer(window));
+        // No delta across leave and enter
+        ctx->_cursor_valid = false;
+        _pushInput(window, {.type = Type::CursorEnter, .args = {entered}});
+    });
+    glfwSetCursorPosCallback(window, [](GLFWwindow* window, double x, double y){
         auto ctx = static_cast<Context*>(glfwGetWindowUserPointer(window));
-        ctx->onKey->emitQueued(ctx->shared_from_this(), key, scancode, action, mods);
-    });
-
-
-    // _bindGlfwCallback<&glfw::Window::setMoveCallback>(onWinMove);
-    // _bindGlfwCallback<&glfw::Window::setResizeCallback>(onWinResize);
-    // _bindGlfwCallback<&glfw::Window::setCloseCallback>(onWinClose);
-    // _bindGlfwCallback<&glfw::Window::setRefreshCallback>(onWinRefresh);
-    // _bindGlfwCallback<&glfw::Window::setIconifyCallback>(onWinIconify);
-    // _bindGlfwCallback<&glfw::Window::setMaximizeCallback>(onWinMaximize);
-    // _bindGlfwCallback<&glfw::Window::setScaleCallback>(onWinScale);
-    // _bindGlfwCallback<&glfw::Window::setFramebufferResizeCallback>(onFramebufferResize);
-
-    // _bindGlfwCallback<&glfw::Window::setCursorFocusCallback>(onCursorFocus);
-    // _bindGlfwCallback<&glfw::Window::setCursorMoveCallback>(onCursorMove);
-    // _bindGlfwCallback<&glfw::Window::setCursorEnterCallback>(onCursorEnter);
-    // _bindGlfwCallback<&glfw::Window::setCursorButtonCallback>(onCursorButton);
-    // _bindGlfwCallback<&glfw::Window::setCursorScrollCallback>(onCursorScroll);
-    // _bindGlfwCallback<&glfw::Window::setKeyCallback>(onKey);
-    // _bindGlfwCallback<&glfw::Window::setCharCallback>(onChar);
+        double dx = ctx->_cursor_valid ? x - ctx->_cursor_x : 0;
+        double dy = ctx->_cursor_valid ? y - ctx->_cursor_y : 0;
+        ctx->_cursor_valid = true;
+        ctx->_cursor_x = x;
+        ctx->_cursor_y = y;
+        _pushInput(window, {.type = Type::CursorMove, .values = {x, y, dx, dy}});
+    });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods){
+        _pushInput(window, {.type = Type::CursorButton, .args = {button, action, mods}});
+    });
+    glfwSetScrollCallback(window, [](GLFWwindow* window, double x, double y){
+        _pushInput(window, {.type = Type::CursorScroll, .values = {x, y}});
+    });
+
+    glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods){
+        _pushInput(window, {.type = Type::Key, .args = {key, scancode, action, mods}});
+    });
+    glfwSetCharCallback(window, [](GLFWwindow* window, unsigned int codepoint){
+        _pushInput(window, {.type = Type::Char, .args = {static_cast<int>(codepoint)}});
+    });
+}
+
+void Context::_pushInput(GLFWwindow* window, const InputEvent& event){
+    // Ring outlives window, no need to lock context
+    auto ctx = static_cast<Context*>(glfwGetWindowUserPointer(window));
+    if (!ctx->_input.push(event)){
+        ++ctx->_input_dropped;
+    }
+}
+
+void Context::_drainInput(InputBatch& batch){
+    std::lock_guard lg(_input_lock);
+    auto self = shared_from_this();
+    InputEvent event;
+    while (_input.pop(event)){
+        switch (event.type){
+        case InputEvent::Type::CursorMove:
+            batch.cursor_dx += event.values[2];
+            batch.cursor_dy += event.values[3];
+            break;
+        case InputEvent::Type::Key:
+            onKey->emitQueued(self, event.args[0], event.args[1], event.args[2], event.args[3]);
+            break;
+        default:
+            break;
+        }
+        batch.events.push_back(event);
+    }
+    batch.dropped = _input_dropped.exchange(0);
+}
+
+void Context::_initLoaders(const Parameters& params){
+    for (unsigned int i = 0; i < params.loader_threads; ++i){
+        // Loaders draw nothing, their windows are never shown
+        _Loader loader{_createWindow(params, _window.get(), false), std::make_shared<BS::thread_pool>(1)};
+        loader.thread->submit([this, window = loader.window.get()](){
+            glfwMakeContextCurrent(window);
+            _current = this;
+        }).wait();
+        _loaders.push_back(loader);
+    }
+}
+
+std::shared_ptr<GLFWwindow> Context::_createWindow(const Parameters& params, GLFWwindow* share, bool visible){
+    auto window = _pump->execute([&params, share, visible](){
+        std::vector<std::pair<int, int>> hints = {
+            // {GLFW_VERSION_MAJOR, 4},
+            // {GLFW_VERSION_MINOR, 6},
+            {GLFW_CONTEXT_VERSION_MAJOR, 4},
+            {GLFW_CONTEXT_VERSION_MINOR, 6},
+            {GLFW_REFRESH_RATE, params.fps},
+            {GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE},
+            {GLFW_FOCUSED, visible ? GLFW_TRUE : GLFW_FALSE},
+        };
+        switch (params.api){
+        case ContextApi::Native:
+            hints.emplace_back(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
+            break;
+        case ContextApi::Egl:
+            hints.emplace_back(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+            break;
+        case ContextApi::OSMesa:
+            hints.emplace_back(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            break;
+        }
+
+        for (auto& hint : hints){
+            glfwWindowHint(hint.first, hint.second);
+        }
+        return glfwCreateWindow(params.width, params.height, params.title.c_str(), NULL, share);
+    });
+    if (!window){
+        throw std::runtime_error("Failed to create GLFW window.");
+    }
+
+    return std::shared_ptr<GLFWwindow>(window, [pump = _pump](GLFWwindow* window){
+        pump->execute([window](){
+            glfwDestroyWindow(window);
+        });
+    });
+}
+
+void Context::_initParallelShaderCompile(){
+    // Not part of core profile, glad loads core functions only
+    using MaxShaderCompilerThreads = void (*)(GLuint);
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i){
+        auto name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        const char* func = nullptr;
+        if (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0){
+            func = "glMaxShaderCompilerThreadsKHR";
+        } else if (std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0){
+            func = "glMaxShaderCompilerThreadsARB";
+        } else {
+            continue;
+        }
+
+        auto max_threads = reinterpret_cast<MaxShaderCompilerThreads>(glfwGetProcAddress(func));
+        if (max_threads){
+            // Let driver pick thread count
+            max_threads(0xFFFFFFFF);
+        }
+        _parallel_shader_compile = true;
+        return;
+    }
 }
\ No newline at end of file
@@ -1,80 +1,248 @@
 #pragma once
 
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+
 #include "BS_thread_pool.hpp"
 
+#include "native/Input.hpp"
 #include "native/utils/Event.hpp"
+#include "native/utils/SpscRing.hpp"
 #include "native/utils/SharedObject.hpp"
 
 struct GLFWwindow;
+struct __GLsync;
 
 namespace nglpmt::native {
 
+class EventPump;
+
 class Context : public SharedObject<Context> {
     std::shared_ptr<BS::thread_pool> _gl_thread;
 public:
+    using us = std::chrono::microseconds;
+
+    // What scheduler does with frame which started after its deadline
+    enum class LatePolicy {
+        // Drops missed frames, next frame keeps original time grid
+        Skip,
+        // Starts new time grid from late frame
+        Reset,
+    };
+
+    // GLFW_CONTEXT_CREATION_API
+    enum class ContextApi {
+        Native,
+        // EGL context, e.g. Mesa llvmpipe. GLFW 3.3 still initialises its
+        // compiled platform, X11 builds need a display such as Xvfb
+        Egl,
+        // Software rendering, GLFW should be built with OSMesa support
+        OSMesa,
+    };
+
     struct Parameters {
         std::string title;
         int width;
         int height;
         int fps;
+        // Paces by glfwSwapBuffers with swap interval 1 instead of fps
+        bool vsync = false;
+        LatePolicy late_policy = LatePolicy::Skip;
+        // Frames recorded ahead of GPU, from 1 to max_frames_in_flight
+        unsigned int frames_in_flight = 2;
+        // Size of frame timings ring
+        unsigned int timing_frames = 120;
+        // Invisible window without presentation, render into GlFramebuffer
+        bool headless = false;
+        ContextApi api = ContextApi::Native;
+        // Threads with own context sharing objects with main one
+        unsigned int loader_threads = 0;
+        // Input events kept between frames, rest is dropped
+        unsigned int input_capacity = 1024;
     };
 
+    struct FrameTiming {
+        uint64_t index = 0;
+        // CPU time of every event
+        us start{0};
+        us run{0};
+        us finish{0};
+        // glfwSwapBuffers presenting previous frame, part of start
+        us swap{0};
+        // GL_TIME_ELAPSED of onRun and onFinish, negative until result is
+        // available or if every timer query was still busy
+        us gpu{-1};
+    };
+    static constexpr unsigned int max_frames_in_flight = 3;
+
     static std::shared_ptr<Context> make(const Parameters& params);
     virtual ~Context();
 
-    std::future<void> run();
+    // Resolves when fewer than frames_in_flight frames are left to execute,
+    // so next frame can be recorded while previous ones are still executed.
+    std::shared_future<void> run();
+    // Same, on_ready is called on gl thread or right away, no thread waits
+    void run(const std::function<void()>& on_ready);
+    // Emits frames on gl thread until stop(), paced by fps or vsync.
+    // run() throws std::logic_error while scheduler is started.
+    void start();
+    void stop();
+    bool isStarted() const;
+    // Frames dropped by LatePolicy::Skip
+    uint64_t getSkippedFrames() const;
+
+    unsigned int getFramesInFlight() const;
+    // gl thread. Index of per-frame resource set for current frame, GPU
+    // finished with previous frame of the same slot before onStart.
+    unsigned int getFrameSlot() const;
+    // Any thread. Last timing_frames frames, oldest first
+    std::vector<FrameTiming> getFrameTimings() const;
     const std::thread::id& getThreadId() const;
+    // True on gl thread and loader threads of this context
+    bool isContextThread() const;
+    // Context current on calling thread, nullptr for non-gl threads
+    static const Context* getCurrent();
+
+    // Runs task on one of loader threads, where GlBuffer/GlTexture/GlShader
+    // methods of this context are executed directly. Resolves after GPU has
+    // finished commands of the task, objects are safe to use on gl thread.
+    // Container objects (GlVertexArray, GlFramebuffer) are not shared and
+    // should not be created by loaders. Without loader threads the task
+    // runs on gl thread.
+    std::future<void> load(const std::function<void()>& task);
+    unsigned int getLoaderThreads() const;
+    // GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile
+    bool hasParallelShaderCompile() const;
+    bool isHeadless() const;
 
     // gl thread
-    using us = std::chrono::microseconds;
     const std::shared_ptr<Event<std::shared_ptr<Context>, const us&>> onStart;
     const std::shared_ptr<Event<std::shared_ptr<Context>, const us&>> onRun;     
     const std::shared_ptr<Event<std::shared_ptr<Context>, const us&>> onFinish;
+    // After onFinish of every scheduled frame: frame index, dt in ms
+    const std::shared_ptr<Event<const std::shared_ptr<Context>, const uint64_t, const double>> onFrame;
     // Event<Context*> onDetsroy;
 
-    // Non-gl thread
-    // Event<Context*, int, int> onWindowMove;
-    // Event<Context*, int, int> onWinResize;
-    // Event<Context*> onWinClose;
-    // Event<Context*> onWinRefresh;
-    // Event<Context*, bool> onWinIconify;
-    // Event<Context*, bool> onWinMaximize;
-    // Event<Context*, float, float> onWinScale;
-    // Event<Context*, int, int> onFramebufferResize;
-
-    // Event<Context*, bool> onCursorFocus;
-    // Event<Context*, bool> onCursorEnter;
-    // Event<Context*, double, double> onCursorMove;
-    // Event<Context*, Button, Action, ModFlags> onCursorButton;
-    // Event<Context*, double, double> onCursorScroll;
-
+    // Input collected by EventPump since previous frame, emitted before
+    // onStart of every frame. Batch is empty if nothing happened.
+    const std::shared_ptr<Event<const std::shared_ptr<Context>, const std::shared_ptr<InputBatch>>> onInput;
+    // Key events of input batch, emitted right before onInput
     const std::shared_ptr<Event<const std::shared_ptr<Context>, const int, const int, const int, const int>> onKey;
-    // Event<Context*, unsigned int, ModFlags> onChar;
 protected:
     Context(const Parameters& params);
     
 private:
-    static std::atomic<unsigned int> _glfw_windows;
-
+    static thread_local const Context* _current;
+
+    // Written by EventPump callbacks, read when frame is emitted
+    SpscRing<InputEvent> _input;
+    std::atomic<uint64_t> _input_dropped = 0;
+    // Keeps ring single consumer, frames are emitted from several threads
+    std::mutex _input_lock;
+    // pump thread
+    bool _cursor_valid = false;
+    double _cursor_x = 0;
+    double _cursor_y = 0;
+
+    // Outlives windows, they are destroyed on pump thread
+    std::shared_ptr<EventPump> _pump;
     std::shared_ptr<GLFWwindow> _window;
 
+    struct _Loader {
+        std::shared_ptr<GLFWwindow> window;
+        // Destroyed before its window
+        std::shared_ptr<BS::thread_pool> thread;
+    };
+    std::vector<_Loader> _loaders;
+    std::atomic<size_t> _next_loader = 0;
+
     Parameters _params;
     std::thread::id _gl_thread_id;
+    bool _parallel_shader_compile = false;
     // uptr<glfw::Window> _glfw_window;
     // std::atomic<bool> _valid;
     std::chrono::steady_clock::time_point _init_time;
     std::chrono::steady_clock::time_point _last_start_time;
     std::chrono::steady_clock::time_point _last_finish_time;
 
+    // OS sleep overshoots by up to a timer slice, last part of wait is
+    // spinning on timer thread
+    static constexpr us _spin_threshold = us(2000);
+    std::atomic<bool> _started = false;
+    // Incremented by start(), frames of previous schedule stop themselves
+    std::atomic<uint64_t> _schedule_id = 0;
+    std::atomic<uint64_t> _frame_index = 0;
+    std::atomic<uint64_t> _skipped_frames = 0;
+    std::chrono::steady_clock::time_point _next_frame_time;
+    // Waits for paced frames, so gl thread keeps running queued tasks
+    std::shared_ptr<BS::thread_pool> _frame_timer;
+
+    std::mutex _frames_lock;
+    // Index and onFinish of last frames_in_flight frames
+    std::deque<std::pair<uint64_t, std::shared_future<void>>> _frames_finished;
+    // run() callbacks by index of the frame they wait for
+    std::map<uint64_t, std::vector<std::function<void()>>> _frame_callbacks;
+    // gl thread
+    uint64_t _gl_frame_index = 0;
+    unsigned int _frame_slot = 0;
+    std::vector<__GLsync*> _frame_fences;
+
+    enum class _Phase {
+        Begin,
+        Start,
+        Run,
+        Finish,
+    };
+    struct _GpuTimer {
+        unsigned int query = 0;
+        uint64_t index = 0;
+        bool pending = false;
+    };
+    // Results are read few frames later, query is skipped if all are pending
+    static constexpr size_t _gpu_timers_count = max_frames_in_flight + 2;
+
+    mutable std::mutex _timings_lock;
+    std::vector<FrameTiming> _timings;
+    uint64_t _timings_written = 0;
+    // gl thread
+    std::chrono::steady_clock::time_point _phase_time;
+    us _swap_time{0};
+    FrameTiming _frame_timing;
+    std::vector<_GpuTimer> _gpu_timers;
+    size_t _gpu_timer_next = 0;
+    _GpuTimer* _gpu_timer_active = nullptr;
+
     void _initGl(const Parameters& params);
+    void _initLoaders(const Parameters& params);
+    // pump thread
+    void _initCallbacks();
+    static void _pushInput(GLFWwindow* window, const InputEvent& event);
+    // Any thread, queues onKey before the frame's onStart
+    void _drainInput(InputBatch& batch);
+    // Any thread, window is created on pump thread
+    std::shared_ptr<GLFWwindow> _createWindow(const Parameters& params, GLFWwindow* share, bool visible);
+    // gl thread
+    void _scheduleFrame(const uint64_t& schedule_id);
+    void _emitScheduledFrame(const uint64_t& schedule_id);
+    // Queues events of one frame, returns its onFinish
+    std::shared_future<void> _emitFrame();
+    // Any thread
+    void _checkNotStarted() const;
+    // gl thread, after onFinish of the frame
+    void _finishFrame(const uint64_t& index);
+    // Advances frame grid, returns start time of next scheduled frame
+    std::chrono::steady_clock::time_point _nextFrameTime();
+    void _beginFrame();
+    // Queued between events of frame, marks end of previous phase
+    void _markPhase(const uint64_t& index, const _Phase& phase);
+    void _recordPhase(const uint64_t& index, const _Phase& phase);
+    void _beginGpuTimer(const uint64_t& index);
+    void _endGpuTimer();
+    void _collectGpuTimers();
+    void _initParallelShaderCompile();
 
-    // template<auto setter, class ... Args>
-    // void _bindGlfwCallback(Event<Context*, Args...> &event){
-    //     std::function<void(glfw::Window*, Args...)> func = [this, &event](glfw::Window*, Args... args){
-    //         event.emit(this, args...);
-    //     };
-    //     (this->_glfw_window.get()->*setter)(func);
-    // };
 };
 
 
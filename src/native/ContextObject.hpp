@@ -15,7 +15,7 @@ public:
     }
 
     inline bool isContextThread() const {
-        return std::this_thread::get_id() == _ctx_thread_id;
+        return Context::getCurrent() == _ctx;
     };
 
     template<auto M>
@@ -26,7 +26,8 @@ public:
 
         auto ctx = _wctx.lock();
         if (ctx){
-            ctx->onRun->addActionQueued([self = this->shared_from_this(), args...](){
+            auto self = std::static_pointer_cast<typename _MemberClass<decltype(M)>::type>(this->shared_from_this());
+            ctx->onRun->addActionQueued([self, args...](){
                 std::invoke(M, self.get(), args...);
                 return false;
             });
@@ -45,7 +46,8 @@ public:
         auto ctx = _wctx.lock();
         if (ctx){
             auto tuple_args = std::make_tuple(std::forward<decltype(args)>(args)...);
-            ctx->onRun->addActionQueued([self = this->shared_from_this(), tuple_args](){
+            auto self = std::static_pointer_cast<std::add_const_t<typename _MemberClass<decltype(M)>::type>>(this->shared_from_this());
+            ctx->onRun->addActionQueued([self, tuple_args](){
                 apply_invoke(M, self.get(), tuple_args);
                 return false;
             });
@@ -59,12 +61,21 @@ protected:
     ContextObject(const std::shared_ptr<Context>& ctx) :
         SharedObject<T>(),
         _wctx(ctx),
-        _ctx_thread_id(ctx->getThreadId()){
+        _ctx(ctx.get()){
     }
 
 private:
     const std::weak_ptr<Context> _wctx;
-    std::thread::id _ctx_thread_id;
+    // Compared only, gl and loader threads of context have it current
+    const Context* _ctx;
+
+    // Methods of derived classes are invoked on derived pointer
+    template<typename M>
+    struct _MemberClass;
+    template<typename R, typename C, typename... A>
+    struct _MemberClass<R (C::*)(A...)> {using type = C;};
+    template<typename R, typename C, typename... A>
+    struct _MemberClass<R (C::*)(A...) const> {using type = const C;};
 
     template<typename F, typename C, typename U>
     static decltype(auto) apply_invoke(F&& func, C&& first, U&& tuple){
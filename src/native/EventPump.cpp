@@ -0,0 +1,89 @@
+#include "native/EventPump.hpp"
+
+#include <stdexcept>
+
+#define GLFW_INCLUDE_NONE
+#include "GLFW/glfw3.h"
+
+using namespace nglpmt::native;
+
+std::shared_ptr<EventPump> EventPump::get(){
+    std::lock_guard lg(_getLock());
+
+    auto& wptr = _getWeak();
+    auto sptr = wptr.lock();
+    if (sptr){return sptr;}
+
+    sptr = std::shared_ptr<EventPump>(new EventPump());
+    wptr = sptr;
+    return sptr;
+}
+
+EventPump::EventPump() :
+    _running(true){
+    std::promise<bool> initialized;
+    auto result = initialized.get_future();
+    _thread = std::thread([this, &initialized](){
+        _loop(initialized);
+    });
+    if (!result.get()){
+        _thread.join();
+        throw std::runtime_error("Failed to initialize GLFW.");
+    }
+}
+
+EventPump::~EventPump(){
+    _running = false;
+    glfwPostEmptyEvent();
+    _thread.join();
+}
+
+bool EventPump::isPumpThread() const {
+    return std::this_thread::get_id() == _thread.get_id();
+}
+
+void EventPump::_push(const std::function<void()>& task){
+    {
+        std::lock_guard lg(_lock);
+        _tasks.push_back(task);
+    }
+    glfwPostEmptyEvent();
+}
+
+void EventPump::_loop(std::promise<bool>& initialized){
+    if (!glfwInit()){
+        _running = false;
+        initialized.set_value(false);
+        return;
+    }
+    initialized.set_value(true);
+
+    while (_running){
+        _runTasks();
+        glfwWaitEventsTimeout(_wait_timeout);
+    }
+    // Windows are destroyed by their contexts before last reference is gone
+    _runTasks();
+    glfwTerminate();
+}
+
+void EventPump::_runTasks(){
+    std::deque<std::function<void()>> tasks;
+    {
+        std::lock_guard lg(_lock);
+        tasks.swap(_tasks);
+    }
+    for (auto& task : tasks){
+        task();
+    }
+}
+
+std::mutex& EventPump::_getLock(){
+    static std::mutex lock;
+    return lock;
+}
+
+std::weak_ptr<EventPump>& EventPump::_getWeak(){
+    static std::weak_ptr<EventPump> ptr;
+    return ptr;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nglpmt::native {
+
+// Owns GLFW for every Context. Initialization, window creation and event
+// polling happen on one thread, callbacks are routed to contexts through
+// window user pointer. Terminates GLFW when last user is released.
+class EventPump {
+public:
+    static std::shared_ptr<EventPump> get();
+    EventPump(const EventPump&) = delete;
+    EventPump(const EventPump&&) = delete;
+    ~EventPump();
+
+    bool isPumpThread() const;
+
+    // Runs func on pump thread and returns its result, inline on pump thread
+    template<typename F>
+    std::invoke_result_t<F> execute(F&& func);
+
+protected:
+    EventPump();
+
+private:
+    // Upper bound of sleep if wake up was missed
+    static constexpr double _wait_timeout = 0.1;
+
+    std::mutex _lock;
+    std::deque<std::function<void()>> _tasks;
+    std::atomic<bool> _running;
+    std::thread _thread;
+
+    void _push(const std::function<void()>& task);
+    void _loop(std::promise<bool>& initialized);
+    void _runTasks();
+
+    static std::mutex& _getLock();
+    static std::weak_ptr<EventPump>& _getWeak();
+};
+
+
+
+
+
+template<typename F>
+inline std::invoke_result_t<F> EventPump::execute(F&& func){
+    if (isPumpThread()){
+        return func();
+    }
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(func));
+    auto result = task->get_future();
+    _push([task](){
+        (*task)();
+    });
+    return result.get();
+}
+
+} // namespace nglpmt::native
\ No newline at end of file
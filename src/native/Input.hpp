@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace nglpmt::native {
+
+// Single GLFW callback, copied through input ring
+struct InputEvent {
+    enum class Type : uint8_t {
+        WindowMove,         // args: x, y
+        WindowResize,       // args: width, height
+        WindowClose,
+        WindowRefresh,
+        WindowFocus,        // args: focused
+        WindowIconify,      // args: iconified
+        WindowMaximize,     // args: maximized
+        WindowScale,        // values: x, y
+        FramebufferResize,  // args: width, height
+        CursorEnter,        // args: entered
+        CursorMove,         // values: x, y, dx, dy
+        CursorButton,       // args: button, action, mods
+        CursorScroll,       // values: x, y
+        Key,                // args: key, scancode, action, mods
+        Char,               // args: codepoint
+    };
+
+    Type type;
+    int args[4] = {};
+    double values[4] = {};
+};
+
+// Input collected since previous frame
+struct InputBatch {
+    std::vector<InputEvent> events;
+    // Sum of CursorMove deltas
+    double cursor_dx = 0;
+    double cursor_dy = 0;
+    // Events lost because input ring was full
+    uint64_t dropped = 0;
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "native/gl/Array.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+BitField GlArrayStatic::_storageFlags(const bool& coherent){
+    BitField flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+    return coherent ? flags | GL_MAP_COHERENT_BIT : flags;
+}
+
+BitField GlArrayStatic::_mapFlags(const bool& coherent){
+    BitField flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+    return coherent ? flags | GL_MAP_COHERENT_BIT : flags | GL_MAP_FLUSH_EXPLICIT_BIT;
+}
+
+void GlArrayStatic::_clientBarrier(const Val<const SrcLoc>& src_loc){
+    // Makes shader writes to persistent storage visible to mapped pointer
+    glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+    GlObjectStatic::debug(src_loc);
+}
\ No newline at end of file
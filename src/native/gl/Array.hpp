@@ -1,72 +1,161 @@
 #pragma once
 
+#include <future>
+#include <limits>
+#include <span>
+
 #include "native/gl/Buffer.hpp"
+#include "native/gl/Sync.hpp"
 
 namespace nglpmt::native {
 
+class GlArrayStatic {
+protected:
+    static BitField _storageFlags(const bool& coherent);
+    static BitField _mapFlags(const bool& coherent);
+    // glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT)
+    static void _clientBarrier(const Val<const SrcLoc>& src_loc);
+};
+
+// Fixed size array in persistently mapped storage. Storage is mapped once,
+// elements are accessed directly through mapped memory. Non-coherent arrays
+// need explicit flush of written elements.
 template<typename T>
-class GlArray : public GlBuffer {
+class GlArray : public GlBuffer, public GlArrayStatic {
 public:
-    static sptr<GlArray> make(const sptr<Context>& ctx,
-                              const Val<const UInt>& size,
-                              const Val<const T>& initial,
-                              const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        auto self = std::shared_ptr<GlArray>(new GlArray(ctx, size, initial, src_loc));
-        static const Val<T*> empty(nullptr);
-        self->storage(self->_size * sizeof(T), empty, _access, src_loc);
-        for (UInt i = 0; i < self->_size; ++i){
-            self->set(i, initial, src_loc);
-        }
-        return self;
-    };
-
-    ~GlArray(){};
-
-    void size(const Val<UInt>& dst,
-              const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) const {
-        if (movedToContext<&GlArray::size>(dst, src_loc)){return;};
-        *dst = _size;
-    }
+    static std::shared_ptr<GlArray> make(const std::shared_ptr<Context>& ctx,
+                                         const Val<const UInt>& size,
+                                         const Val<const T>& initial = T{},
+                                         const Val<const bool>& coherent = true,
+                                         const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlArray(){};
 
-    void get(const Val<T>& dst,
-             const Val<const UInt>& i,
-             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) const {
-        if (movedToContext<&GlArray::get>(dst, i, src_loc)){return;}
-        Val<T*> mapped;
-        mapRange(mapped, *i * sizeof(T), sizeof(T), _access, src_loc);
-        *dst = *mapped;
-        unmap(true, src_loc);
-    }
+    // Any thread. View is empty until storage is mapped on context thread
+    std::span<T> view() const;
+    bool isReady() const;
+    UInt size() const;
+    bool isCoherent() const;
 
-    bool set(const Val<const T>& value,
-             const Val<const UInt>& i, 
-             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (movedToContext<&GlArray::set>(value, i, src_loc)){return;}
-        Val<void*> mapped(nullptr);
-        mapRange(mapped, *i * sizeof(T), sizeof(T), _access, src_loc);
-        auto mapped_struct = mapped.cast_reinterpret<T*>();
-        **mapped_struct = *value;
-        unmap(true, src_loc);
-    }
+    // glFlushMappedNamedBufferRange, no-op for coherent storage
+    void flush(const Val<const UInt>& first = 0,
+               const Val<const UInt>& count = std::numeric_limits<UInt>::max(),
+               const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // Resolves when GPU finished every command queued before this call,
+    // after that mapped memory is safe to read and rewrite.
+    std::future<void> waitIdle(const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
 
 protected:
-    Array(const sptr<Context>& ctx,
-          const Val<const UInt>& size,
-          const Val<const T>& initial,
-          const Val<const utils::SrcLoc>& src_loc) :
-        Buffer(ctx, src_loc),
-        _size(size){
-    }
+    GlArray(const std::shared_ptr<Context>& ctx,
+            const UInt& size,
+            const bool& coherent,
+            const Val<const SrcLoc>& src_loc);
 
 private:
     // Hide parent's make
-    using Buffer::make;
+    using GlBuffer::make;
 
-    UInt _size;
-    static inline BitField _access = static_cast<Enum>(BufferStorageFlag::Read)
-                                   | static_cast<Enum>(BufferStorageFlag::Write)
-                                   | static_cast<Enum>(BufferStorageFlag::Persistent)
-                                   | static_cast<Enum>(BufferStorageFlag::Coherent);
+    const UInt _size;
+    const bool _coherent;
+    Val<void*> _mapped;
+    std::atomic<T*> _data;
+
+    // context thread
+    void _init(const T& initial, const Val<const SrcLoc>& src_loc);
+    void _barrier(const Val<const SrcLoc>& src_loc) const;
 };
 
+template<typename T>
+inline std::shared_ptr<GlArray<T>> GlArray<T>::make(const std::shared_ptr<Context>& ctx,
+                                                    const Val<const UInt>& size,
+                                                    const Val<const T>& initial,
+                                                    const Val<const bool>& coherent,
+                                                    const Val<const SrcLoc>& src_loc){
+    auto self = std::shared_ptr<GlArray>(new GlArray(ctx, *size, *coherent, src_loc));
+    if (self->isContextThread()){
+        self->_init(*initial, src_loc);
+    } else {
+        ctx->onRun->addActionQueued([self, initial, src_loc](){
+            self->_init(*initial, src_loc);
+            return false;
+        });
+    }
+    return self;
+}
+
+template<typename T>
+inline GlArray<T>::GlArray(const std::shared_ptr<Context>& ctx,
+                           const UInt& size,
+                           const bool& coherent,
+                           const Val<const SrcLoc>& src_loc) :
+    GlBuffer(ctx, src_loc),
+    _size(size),
+    _coherent(coherent),
+    _mapped(nullptr),
+    _data(nullptr){
+}
+
+template<typename T>
+inline std::span<T> GlArray<T>::view() const {
+    auto data = _data.load();
+    return data ? std::span<T>(data, _size) : std::span<T>();
+}
+
+template<typename T>
+inline bool GlArray<T>::isReady() const {
+    return _data.load() != nullptr;
+}
+
+template<typename T>
+inline UInt GlArray<T>::size() const {
+    return _size;
+}
+
+template<typename T>
+inline bool GlArray<T>::isCoherent() const {
+    return _coherent;
+}
+
+template<typename T>
+inline void GlArray<T>::flush(const Val<const UInt>& first,
+                              const Val<const UInt>& count,
+                              const Val<const SrcLoc>& src_loc){
+    if (_coherent){return;}
+    if (movedToContext<&GlArray::flush>(first, count, src_loc)){return;}
+    if (*first >= _size){return;}
+    UInt n = std::min(*count, _size - *first);
+    flushMappedRange(*first * sizeof(T), n * sizeof(T), src_loc);
+}
+
+template<typename T>
+inline std::future<void> GlArray<T>::waitIdle(const Val<const SrcLoc>& src_loc) const {
+    auto ctx = getContext().lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+    _barrier(src_loc);
+    return GlSync::make(ctx, src_loc)->whenSignaled(src_loc);
+}
+
+template<typename T>
+inline void GlArray<T>::_init(const T& initial, const Val<const SrcLoc>& src_loc){
+    static const Val<const void> empty(std::shared_ptr<const void>(nullptr));
+
+    SizeiPtr bytes = std::max<SizeiPtr>(_size * sizeof(T), 1);
+    storage(bytes, empty, _storageFlags(_coherent), src_loc);
+    mapRange(_mapped, 0, bytes, _mapFlags(_coherent), src_loc);
+    auto data = static_cast<T*>(*_mapped);
+    std::fill(data, data + _size, initial);
+    if (!_coherent){
+        flushMappedRange(0, bytes, src_loc);
+    }
+    _data = data;
+}
+
+template<typename T>
+inline void GlArray<T>::_barrier(const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlArray::_barrier>(src_loc)){return;}
+    _clientBarrier(src_loc);
+}
+
 } // namespace nglpmt::native
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "native/gl/BlockWriter.hpp"
+
+#include <cstring>
+
+using namespace nglpmt::native;
+
+GlBlockWriter::GlBlockWriter(const GlBlockLayout& layout,
+                             void* data,
+                             const SizeiPtr& size) :
+    _layout(layout),
+    _data(static_cast<UByte*>(data)),
+    _size(size){
+    if (!_data || _size < _layout.size){
+        throw std::invalid_argument("GlBlockWriter: memory is smaller than block " + _layout.name);
+    }
+}
+
+GlBlockWriter::GlBlockWriter(const GlBlockLayout& layout,
+                             const GlBufferAllocator::Range& range) :
+    GlBlockWriter(layout, range.data, range.size){
+}
+
+const GlBlockLayout& GlBlockWriter::getLayout() const {
+    return _layout;
+}
+
+void GlBlockWriter::_write(const GlUniformName& name,
+                           const UInt& element,
+                           const void* value,
+                           const size_t& size){
+    auto member = _layout.findMember(name);
+    if (!member){
+        throw std::invalid_argument("GlBlockWriter: unknown member of block " + _layout.name);
+    }
+
+    auto shape = GlTypeShape::of(member->type);
+    size_t packed = static_cast<size_t>(shape.component_size) * shape.rows * shape.columns;
+    if (packed == 0 || packed != size){
+        throw std::invalid_argument("GlBlockWriter: value size does not match " + member->name);
+    }
+    if (element >= static_cast<UInt>(std::max(member->array_size, 1))){
+        throw std::out_of_range("GlBlockWriter: " + member->name + " index is out of range");
+    }
+
+    auto src = static_cast<const UByte*>(value);
+    SizeiPtr base = member->offset + static_cast<SizeiPtr>(element) * member->array_stride;
+    if (shape.columns == 1){
+        if (base + static_cast<SizeiPtr>(size) > _size){
+            throw std::out_of_range("GlBlockWriter: " + member->name + " is out of memory range");
+        }
+        std::memcpy(_data + base, src, size);
+        return;
+    }
+
+    Int comp = shape.component_size;
+    for (Int c = 0; c < shape.columns; ++c){
+        for (Int r = 0; r < shape.rows; ++r){
+            SizeiPtr dst = base + (member->row_major ? r * member->matrix_stride + c * comp
+                                                     : c * member->matrix_stride + r * comp);
+            if (dst + comp > _size){
+                throw std::out_of_range("GlBlockWriter: " + member->name + " is out of memory range");
+            }
+            std::memcpy(_data + dst, src + (c * shape.rows + r) * comp, comp);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "native/gl/BufferAllocator.hpp"
+#include "native/gl/Program.hpp"
+
+namespace nglpmt::native {
+
+// Writes values into memory laid out as reflected block, e.g. mapped
+// GlBufferAllocator range. Value sizes are checked against member types,
+// matrices are written column by column with reflected matrix stride.
+class GlBlockWriter {
+public:
+    GlBlockWriter(const GlBlockLayout& layout,
+                  void* data,
+                  const SizeiPtr& size);
+    GlBlockWriter(const GlBlockLayout& layout,
+                  const GlBufferAllocator::Range& range);
+
+    // Column-major tightly packed values, like glm types
+    template<typename T>
+    void set(const GlUniformName& member,
+             const T& value,
+             const UInt& element = 0){
+        static_assert(std::is_trivially_copyable_v<T>);
+        _write(member, element, &value, sizeof(T));
+    }
+
+    const GlBlockLayout& getLayout() const;
+
+private:
+    const GlBlockLayout _layout;
+    UByte* const _data;
+    const SizeiPtr _size;
+
+    void _write(const GlUniformName& member,
+                const UInt& element,
+                const void* value,
+                const size_t& size);
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "native/gl/BufferAllocator.hpp"
+
+#include <bit>
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+namespace {
+    // Max alignment allowed by spec, used until real values are queried
+    static constexpr SizeiPtr default_alignment = 256;
+
+    static UInt getOrder(const SizeiPtr& blocks){
+        return static_cast<UInt>(std::bit_width(std::bit_ceil(static_cast<UInt64>(blocks))) - 1);
+    }
+}
+
+std::shared_ptr<GlBufferAllocator> GlBufferAllocator::make(const std::shared_ptr<Context>& ctx,
+                                                           const Val<const SizeiPtr>& size,
+                                                           const Val<const BitField>& flags,
+                                                           const Val<const SizeiPtr>& min_block,
+                                                           const Val<const SrcLoc>& src_loc){
+    if (*size <= 0 || *min_block <= 0){
+        throw std::invalid_argument("GlBufferAllocator size must be positive");
+    }
+
+    auto self = std::shared_ptr<GlBufferAllocator>(new GlBufferAllocator(ctx, *size, *flags, *min_block, src_loc));
+    if (self->_buffer->isContextThread()){
+        self->_init(src_loc);
+    } else {
+        ctx->onRun->addActionQueued([self, src_loc](){
+            self->_init(src_loc);
+            return false;
+        });
+    }
+
+    ctx->onRun->addActionQueued([wself = std::weak_ptr<GlBufferAllocator>(self)](){
+        auto self = wself.lock();
+        if (!self){
+            return false;
+        }
+        self->_update();
+        return true;
+    });
+    return self;
+}
+
+GlBufferAllocator::GlBufferAllocator(const std::shared_ptr<Context>& ctx,
+                                     const SizeiPtr& size,
+                                     const BitField& flags,
+                                     const SizeiPtr& min_block,
+                                     const Val<const SrcLoc>& src_loc) :
+    _wctx(ctx),
+    _buffer(GlBuffer::make(ctx, src_loc)),
+    _flags(flags),
+    _min_block(static_cast<SizeiPtr>(std::bit_ceil(static_cast<UInt64>(min_block)))),
+    _max_order(getOrder((size + _min_block - 1) / _min_block)),
+    _mapped(nullptr),
+    _data(nullptr),
+    _uniform_alignment(default_alignment),
+    _storage_alignment(default_alignment),
+    _free(_max_order + 1),
+    _used(0){
+    _free[_max_order].insert(0);
+}
+
+GlBufferAllocator::~GlBufferAllocator(){
+}
+
+std::shared_ptr<const GlBufferAllocator::Range> GlBufferAllocator::allocate(const SizeiPtr& size,
+                                                                            const SizeiPtr& alignment){
+    bool persistent = _flags & GL_MAP_PERSISTENT_BIT;
+    auto data = _data.load();
+    if (size <= 0 || (persistent && !data)){
+        return nullptr;
+    }
+
+    SizeiPtr need = std::max(size, static_cast<SizeiPtr>(std::bit_ceil(static_cast<UInt64>(std::max<SizeiPtr>(alignment, 1)))));
+    UInt order = getOrder((need + _min_block - 1) / _min_block);
+    if (order > _max_order){
+        return nullptr;
+    }
+
+    std::optional<IntPtr> offset;
+    {
+        std::lock_guard lg(_lock);
+        offset = _take(order);
+        if (!offset){
+            return nullptr;
+        }
+        _used += _min_block << order;
+    }
+
+    auto range = new Range{_buffer, offset.value(), size, persistent ? data + offset.value() : nullptr};
+    return std::shared_ptr<const Range>(range, [wself = weak_from_this(), order](const Range* range){
+        auto self = wself.lock();
+        if (self){
+            self->_release(range->offset, order);
+        }
+        delete range;
+    });
+}
+
+std::shared_ptr<const GlBufferAllocator::Range> GlBufferAllocator::allocateUniform(const SizeiPtr& size){
+    return allocate(size, _uniform_alignment);
+}
+
+std::shared_ptr<const GlBufferAllocator::Range> GlBufferAllocator::allocateShaderStorage(const SizeiPtr& size){
+    return allocate(size, _storage_alignment);
+}
+
+const std::shared_ptr<GlBuffer>& GlBufferAllocator::getBuffer() const {
+    return _buffer;
+}
+
+SizeiPtr GlBufferAllocator::getSize() const {
+    return _min_block << _max_order;
+}
+
+SizeiPtr GlBufferAllocator::getUsedSize() const {
+    std::lock_guard lg(_lock);
+    return _used;
+}
+
+// Should be called when mutex is locked
+std::optional<IntPtr> GlBufferAllocator::_take(const UInt& order){
+    UInt found = order;
+    while (found <= _max_order && _free[found].empty()){
+        ++found;
+    }
+    if (found > _max_order){
+        return std::nullopt;
+    }
+
+    IntPtr offset = *_free[found].begin();
+    _free[found].erase(_free[found].begin());
+    // Split down, upper halves stay free
+    while (found > order){
+        --found;
+        _free[found].insert(offset + (_min_block << found));
+    }
+    return offset;
+}
+
+// Should be called when mutex is locked
+void GlBufferAllocator::_give(IntPtr offset, UInt order){
+    while (order < _max_order){
+        IntPtr buddy = offset ^ (_min_block << order);
+        auto iter = _free[order].find(buddy);
+        if (iter == _free[order].end()){
+            break;
+        }
+        _free[order].erase(iter);
+        offset = std::min(offset, buddy);
+        ++order;
+    }
+    _free[order].insert(offset);
+}
+
+void GlBufferAllocator::_release(const IntPtr& offset, const UInt& order){
+    auto ctx = _wctx.lock();
+    if (!ctx){
+        return;
+    }
+    // Range can be reused only after commands reading it are finished
+    auto fence = GlSync::make(ctx);
+
+    std::lock_guard lg(_lock);
+    _pending.push_back(Pending{offset, order, fence});
+}
+
+void GlBufferAllocator::_init(const Val<const SrcLoc>& src_loc){
+    static const Val<const void> empty(std::shared_ptr<const void>(nullptr));
+
+    SizeiPtr size = getSize();
+    _buffer->storage(size, empty, _flags, src_loc);
+    if (_flags & GL_MAP_PERSISTENT_BIT){
+        BitField access = _flags & (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        _buffer->mapRange(_mapped, 0, size, access, src_loc);
+        _data = static_cast<UByte*>(*_mapped);
+    }
+
+    Int alignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    _uniform_alignment = alignment;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    _storage_alignment = alignment;
+    GlObjectStatic::debug(src_loc);
+}
+
+void GlBufferAllocator::_update(){
+    std::lock_guard lg(_lock);
+    GlSync::retireSignaled(_pending, [this](const Pending& pending){
+        _give(pending.offset, pending.order);
+        _used -= _min_block << pending.order;
+    });
+}
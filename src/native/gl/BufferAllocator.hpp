@@ -0,0 +1,82 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "native/gl/Buffer.hpp"
+#include "native/gl/Sync.hpp"
+
+namespace nglpmt::native {
+
+// Buddy suballocator over one immutable GlBuffer. Ranges are aligned to their
+// own size, so UBO/SSBO offset alignment holds for free.
+class GlBufferAllocator : public SharedObject<GlBufferAllocator> {
+public:
+    struct Range {
+        std::shared_ptr<GlBuffer> buffer;
+        IntPtr offset;
+        SizeiPtr size;
+        // Only for storage with GL_MAP_PERSISTENT_BIT
+        void* data;
+    };
+
+    static std::shared_ptr<GlBufferAllocator> make(const std::shared_ptr<Context>& ctx,
+                                                   const Val<const SizeiPtr>& size,
+                                                   const Val<const BitField>& flags,
+                                                   const Val<const SizeiPtr>& min_block = 256,
+                                                   const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlBufferAllocator();
+
+    // Any thread. Range returns to allocator after the GPU is done with it.
+    // Block of min_block times power of two is reserved, Range::size keeps
+    // requested size, reserved one is counted by getUsedSize()
+    std::shared_ptr<const Range> allocate(const SizeiPtr& size,
+                                          const SizeiPtr& alignment = 1);
+    std::shared_ptr<const Range> allocateUniform(const SizeiPtr& size);
+    std::shared_ptr<const Range> allocateShaderStorage(const SizeiPtr& size);
+
+    const std::shared_ptr<GlBuffer>& getBuffer() const;
+    SizeiPtr getSize() const;
+    SizeiPtr getUsedSize() const;
+
+protected:
+    GlBufferAllocator(const std::shared_ptr<Context>& ctx,
+                      const SizeiPtr& size,
+                      const BitField& flags,
+                      const SizeiPtr& min_block,
+                      const Val<const SrcLoc>& src_loc);
+
+private:
+    struct Pending {
+        IntPtr offset;
+        UInt order;
+        std::shared_ptr<GlSync> fence;
+    };
+
+    const std::weak_ptr<Context> _wctx;
+    const std::shared_ptr<GlBuffer> _buffer;
+    const BitField _flags;
+    const SizeiPtr _min_block;
+    const UInt _max_order;
+    Val<void*> _mapped;
+    std::atomic<UByte*> _data;
+    std::atomic<SizeiPtr> _uniform_alignment;
+    std::atomic<SizeiPtr> _storage_alignment;
+
+    mutable std::mutex _lock;
+    std::vector<std::set<IntPtr>> _free;
+    std::vector<Pending> _pending;
+    SizeiPtr _used;
+
+    std::optional<IntPtr> _take(const UInt& order);
+    void _give(IntPtr offset, UInt order);
+    void _release(const IntPtr& offset, const UInt& order);
+
+    // context thread
+    void _init(const Val<const SrcLoc>& src_loc);
+    void _update();
+};
+
+} // namespace nglpmt::native
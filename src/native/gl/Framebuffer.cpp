@@ -0,0 +1,103 @@
+#include "native/gl/Framebuffer.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+std::shared_ptr<GlFramebuffer> GlFramebuffer::make(const std::shared_ptr<Context>& ctx,
+                                                   const Val<const SrcLoc>& src_loc){
+    return std::shared_ptr<GlFramebuffer>(new GlFramebuffer(ctx, src_loc));
+}
+
+GlFramebuffer::GlFramebuffer(const std::shared_ptr<Context>& ctx, const Val<const SrcLoc>& src_loc) :
+    GlObject(ctx, &GlFramebuffer::_initer, &GlFramebuffer::_deleter, src_loc){
+}
+
+void GlFramebuffer::attachTexture(const Val<const Enum>& attachment,
+                                  const Val<const GlTexture>& texture,
+                                  const Val<const Int>& level,
+                                  const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlFramebuffer::attachTexture>(attachment, texture, level, src_loc)){return;}
+    glNamedFramebufferTexture(id(), attachment, texture->id(), level);
+    debug(src_loc);
+}
+
+void GlFramebuffer::setDrawBuffer(const Val<const Enum>& buf,
+                                  const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlFramebuffer::setDrawBuffer>(buf, src_loc)){return;}
+    glNamedFramebufferDrawBuffer(id(), buf);
+    debug(src_loc);
+}
+
+void GlFramebuffer::setReadBuffer(const Val<const Enum>& src,
+                                  const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlFramebuffer::setReadBuffer>(src, src_loc)){return;}
+    glNamedFramebufferReadBuffer(id(), src);
+    debug(src_loc);
+}
+
+void GlFramebuffer::checkStatus(const Val<const Enum>& target,
+                                const Val<Enum>& dst,
+                                const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlFramebuffer::checkStatus>(target, dst, src_loc)){return;}
+    *dst = glCheckNamedFramebufferStatus(id(), target);
+    debug(src_loc);
+}
+
+void GlFramebuffer::clearfv(const Val<const Enum>& buffer,
+                            const Val<const Int>& drawbuffer,
+                            const Val<const Float[]>& value,
+                            const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlFramebuffer::clearfv>(buffer, drawbuffer, value, src_loc)){return;}
+    glClearNamedFramebufferfv(id(), buffer, drawbuffer, value);
+    debug(src_loc);
+}
+
+void GlFramebuffer::bind(const Val<const Enum>& target,
+                         const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlFramebuffer::bind>(target, src_loc)){return;}
+    glBindFramebuffer(target, id());
+    debug(src_loc);
+}
+
+void GlFramebuffer::bindDefault(const std::shared_ptr<Context>& ctx,
+                                const Val<const Enum>& target,
+                                const Val<const SrcLoc>& src_loc){
+    if (!ctx->isContextThread()){
+        ctx->onRun->addActionQueued([target, src_loc](){
+            glBindFramebuffer(*target, 0);
+            debug(src_loc);
+            return false;
+        });
+        return;
+    }
+    glBindFramebuffer(target, 0);
+    debug(src_loc);
+}
+
+void GlFramebuffer::readPixels(const Val<const Int>& x,
+                               const Val<const Int>& y,
+                               const Val<const Sizei>& width,
+                               const Val<const Sizei>& height,
+                               const Val<const Enum>& format,
+                               const Val<const Enum>& type,
+                               const Val<void>& pixels,
+                               const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlFramebuffer::readPixels>(x, y, width, height, format, type, pixels, src_loc)){return;}
+    // glReadPixels has no DSA form, previous read binding is restored
+    Int previous = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, id());
+    glReadPixels(x, y, width, height, format, type, pixels);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<UInt>(previous));
+    debug(src_loc);
+}
+
+void GlFramebuffer::_initer(const Val<UInt>& dst, const Val<const SrcLoc>& src_loc){
+    glCreateFramebuffers(1, dst);
+    debug(src_loc);
+}
+
+void GlFramebuffer::_deleter(const UInt& id){
+    glDeleteFramebuffers(1, &id);
+}
\ No newline at end of file
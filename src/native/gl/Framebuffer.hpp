@@ -0,0 +1,69 @@
+#pragma once
+
+#include "native/gl/Object.hpp"
+#include "native/gl/Texture.hpp"
+
+namespace nglpmt::native {
+
+// Render target for headless contexts and offscreen passes
+class GlFramebuffer : public GlObject<GlFramebuffer> {
+public:
+    static std::shared_ptr<GlFramebuffer> make(const std::shared_ptr<Context>& ctx,
+                                               const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glNamedFramebufferTexture
+    void attachTexture(const Val<const Enum>& attachment,
+                       const Val<const GlTexture>& texture,
+                       const Val<const Int>& level = 0,
+                       const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glNamedFramebufferDrawBuffer
+    void setDrawBuffer(const Val<const Enum>& buf,
+                       const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glNamedFramebufferReadBuffer
+    void setReadBuffer(const Val<const Enum>& src,
+                       const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glCheckNamedFramebufferStatus
+    void checkStatus(const Val<const Enum>& target,
+                     const Val<Enum>& dst,
+                     const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glClearNamedFramebufferfv
+    void clearfv(const Val<const Enum>& buffer,
+                 const Val<const Int>& drawbuffer,
+                 const Val<const Float[]>& value,
+                 const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glBindFramebuffer
+    void bind(const Val<const Enum>& target,
+              const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glBindFramebuffer with 0, rebinds default framebuffer
+    static void bindDefault(const std::shared_ptr<Context>& ctx,
+                            const Val<const Enum>& target,
+                            const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glReadPixels from read buffer of this framebuffer
+    void readPixels(const Val<const Int>& x,
+                    const Val<const Int>& y,
+                    const Val<const Sizei>& width,
+                    const Val<const Sizei>& height,
+                    const Val<const Enum>& format,
+                    const Val<const Enum>& type,
+                    const Val<void>& pixels,
+                    const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+protected:
+    GlFramebuffer(const std::shared_ptr<Context>& ctx,
+                  const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+private:
+    static void _initer(const Val<UInt>& dst,
+                        const Val<const SrcLoc>& src_loc);
+
+    static void _deleter(const UInt& id);
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "native/gl/StreamBuffer.hpp"
+#include "native/gl/VertexArray.hpp"
+
+namespace nglpmt::native {
+
+// Layout of glMultiDrawElementsIndirect command
+struct GlDrawElementsIndirectCommand {
+    UInt count;
+    UInt instance_count;
+    UInt first_index;
+    Int base_vertex;
+    UInt base_instance;
+};
+
+// Layout of glMultiDrawArraysIndirect command
+struct GlDrawArraysIndirectCommand {
+    UInt count;
+    UInt instance_count;
+    UInt first;
+    UInt base_instance;
+};
+
+// Fills draw commands straight into GlStreamBuffer memory from any number
+// of threads, whole batch is then submitted with one multi-draw call.
+// Builder is valid within the frame it was made in.
+template<typename Command>
+class GlIndirectBuilder {
+public:
+    // Returns nullptr when stream has no room left in current frame
+    static std::shared_ptr<GlIndirectBuilder> make(const std::shared_ptr<GlStreamBuffer>& stream,
+                                                   const UInt& capacity);
+
+    // Any thread. Returns false when builder is full
+    bool push(const Command& command);
+
+    UInt getCount() const;
+    UInt getCapacity() const;
+
+    // Queues multi-draw of commands pushed so far, pushes have to be finished
+    void draw(const std::shared_ptr<GlVertexArray>& vao,
+              const Enum& mode,
+              const Enum& type,
+              const Val<const SrcLoc>& src_loc = SrcLoc{}) const requires std::is_same_v<Command, GlDrawElementsIndirectCommand>;
+
+    void draw(const std::shared_ptr<GlVertexArray>& vao,
+              const Enum& mode,
+              const Val<const SrcLoc>& src_loc = SrcLoc{}) const requires std::is_same_v<Command, GlDrawArraysIndirectCommand>;
+
+protected:
+    GlIndirectBuilder(const std::shared_ptr<GlStreamBuffer>& stream,
+                      const GlStreamBuffer::Allocation& allocation,
+                      const UInt& capacity);
+
+private:
+    const std::shared_ptr<GlStreamBuffer> _stream;
+    const IntPtr _offset;
+    Command* const _data;
+    const UInt _capacity;
+    std::atomic<UInt> _count;
+};
+
+using GlElementsIndirectBuilder = GlIndirectBuilder<GlDrawElementsIndirectCommand>;
+using GlArraysIndirectBuilder = GlIndirectBuilder<GlDrawArraysIndirectCommand>;
+
+template<typename Command>
+inline std::shared_ptr<GlIndirectBuilder<Command>> GlIndirectBuilder<Command>::make(const std::shared_ptr<GlStreamBuffer>& stream,
+                                                                                    const UInt& capacity){
+    auto allocation = stream->allocate(capacity * sizeof(Command), alignof(Command));
+    if (!allocation){
+        return nullptr;
+    }
+    return std::shared_ptr<GlIndirectBuilder>(new GlIndirectBuilder(stream, *allocation, capacity));
+}
+
+template<typename Command>
+inline GlIndirectBuilder<Command>::GlIndirectBuilder(const std::shared_ptr<GlStreamBuffer>& stream,
+                                                     const GlStreamBuffer::Allocation& allocation,
+                                                     const UInt& capacity) :
+    _stream(stream),
+    _offset(allocation.offset),
+    _data(static_cast<Command*>(allocation.data)),
+    _capacity(capacity),
+    _count(0){
+}
+
+template<typename Command>
+inline bool GlIndirectBuilder<Command>::push(const Command& command){
+    UInt index = _count.fetch_add(1);
+    if (index >= _capacity){
+        return false;
+    }
+    _data[index] = command;
+    return true;
+}
+
+template<typename Command>
+inline UInt GlIndirectBuilder<Command>::getCount() const {
+    return std::min(_count.load(), _capacity);
+}
+
+template<typename Command>
+inline UInt GlIndirectBuilder<Command>::getCapacity() const {
+    return _capacity;
+}
+
+template<typename Command>
+inline void GlIndirectBuilder<Command>::draw(const std::shared_ptr<GlVertexArray>& vao,
+                                             const Enum& mode,
+                                             const Enum& type,
+                                             const Val<const SrcLoc>& src_loc) const requires std::is_same_v<Command, GlDrawElementsIndirectCommand> {
+    auto count = getCount();
+    if (count > 0){
+        vao->multiDrawElementsIndirect(mode, type, _stream, _offset, count, sizeof(Command), src_loc);
+    }
+}
+
+template<typename Command>
+inline void GlIndirectBuilder<Command>::draw(const std::shared_ptr<GlVertexArray>& vao,
+                                             const Enum& mode,
+                                             const Val<const SrcLoc>& src_loc) const requires std::is_same_v<Command, GlDrawArraysIndirectCommand> {
+    auto count = getCount();
+    if (count > 0){
+        vao->multiDrawArraysIndirect(mode, _stream, _offset, count, sizeof(Command), src_loc);
+    }
+}
+
+} // namespace nglpmt::native
\ No newline at end of file
@@ -4,6 +4,11 @@
 
 using namespace nglpmt::native;
 
+namespace {
+    // GL_KHR_parallel_shader_compile
+    static constexpr Enum completion_status = 0x91B1;
+}
+
 std::optional<std::string> GlObjectStatic::getGlMessage(const SrcLoc& src_loc){
     Enum err = glGetError();
     if (err == GL_NO_ERROR){
@@ -30,4 +35,87 @@ std::optional<std::string> GlObjectStatic::getGlMessage(const SrcLoc& src_loc){
     }
     msg += "\n==========";
     return msg;
+}
+
+std::future<bool> GlObjectStatic::_whenCompleted(const std::shared_ptr<Context>& ctx,
+                                                 const std::function<void()>& start,
+                                                 const std::function<Int(const Enum&)>& get,
+                                                 const Enum& status,
+                                                 const std::function<void()>& on_done,
+                                                 const Val<const SrcLoc>& src_loc){
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto result = promise->get_future();
+    auto finish = [promise, on_done](bool success){
+        if (success && on_done){
+            on_done();
+        }
+        promise->set_value(success);
+    };
+
+    if (!ctx->hasParallelShaderCompile() && ctx->getLoaderThreads() > 0){
+        // Loader blocks on status instead of gl thread. Handed off from gl
+        // thread behind queued initer, source and attach commands, the fence
+        // makes them visible to loader context.
+        auto handoff = [wctx = std::weak_ptr<Context>(ctx), start, get, status, finish, promise](){
+            auto ctx = wctx.lock();
+            if (!ctx){
+                return;
+            }
+            auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+            auto success = std::make_shared<bool>(false);
+            auto loaded = ctx->load([fence, start, get, status, success](){
+                glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+                glDeleteSync(fence);
+                start();
+                *success = get(status) == GL_TRUE;
+            }).share();
+            ctx->onRun->addActionQueued([loaded, success, finish, promise](){
+                if (loaded.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+                    return true;
+                }
+                try {
+                    loaded.get();
+                    finish(*success);
+                } catch (...){
+                    promise->set_exception(std::current_exception());
+                }
+                return false;
+            });
+        };
+        if (ctx->isContextThread()){
+            handoff();
+        } else {
+            ctx->onRun->addActionQueued([handoff](){
+                handoff();
+                return false;
+            });
+        }
+        return result;
+    }
+
+    bool parallel = ctx->hasParallelShaderCompile();
+    auto started = std::make_shared<bool>(false);
+    if (ctx->isContextThread()){
+        start();
+        *started = true;
+    }
+    ctx->onRun->addActionQueued([start, get, status, finish, parallel, started, src_loc](){
+        if (!*started){
+            start();
+            *started = true;
+            if (!parallel){
+                // Driver may still finish in its own threads until next frame
+                return true;
+            }
+        }
+        if (parallel && get(completion_status) != GL_TRUE){
+            return true;
+        }
+        bool success = get(status) == GL_TRUE;
+        debug(src_loc);
+        finish(success);
+        return false;
+    });
+    return result;
 }
\ No newline at end of file
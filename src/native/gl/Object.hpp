@@ -17,6 +17,21 @@ public:
     }
 #endif
     }
+
+protected:
+    // Compile/link completion for shaders and programs. start issues the
+    // command, get reads object parameter, status is GL_COMPILE_STATUS or
+    // GL_LINK_STATUS. GL_COMPLETION_STATUS_KHR is polled every frame, without
+    // parallel compile support the work is done on a loader thread if there
+    // is one, after commands queued before the call, otherwise status is
+    // read next frame. on_done is called on gl
+    // thread before resolving, only for successful status.
+    static std::future<bool> _whenCompleted(const std::shared_ptr<Context>& ctx,
+                                            const std::function<void()>& start,
+                                            const std::function<Int(const Enum&)>& get,
+                                            const Enum& status,
+                                            const std::function<void()>& on_done,
+                                            const Val<const SrcLoc>& src_loc);
 };
 
 template<typename T>
@@ -56,7 +71,7 @@ private:
                 return;
             }
 
-            if (ctx->getThreadId() == std::this_thread::get_id()){
+            if (ctx->isContextThread()){
                 deleter(*id);
             } else {
                 ctx->onRun->addActionQueued([deleter, id](){
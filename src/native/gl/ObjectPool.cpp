@@ -0,0 +1,37 @@
+#include "native/gl/ObjectPool.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+template<>
+std::shared_ptr<GlBuffer> GlBufferPool::_create(const std::shared_ptr<Context>& ctx,
+                                                const GlBufferPoolKey& key,
+                                                const Val<const SrcLoc>& src_loc){
+    static const Val<const void> empty(std::shared_ptr<const void>(nullptr));
+
+    auto buffer = GlBuffer::make(ctx, src_loc);
+    buffer->storage(key.size, empty, key.flags, src_loc);
+    return buffer;
+}
+
+template<>
+std::shared_ptr<GlTexture> GlTexturePool::_create(const std::shared_ptr<Context>& ctx,
+                                                  const GlTexturePoolKey& key,
+                                                  const Val<const SrcLoc>& src_loc){
+    auto texture = GlTexture::make(ctx, key.type, src_loc);
+    switch (key.type){
+    case GL_TEXTURE_1D:
+        texture->storage1D(key.levels, key.internalformat, key.width, src_loc);
+        break;
+    case GL_TEXTURE_3D:
+    case GL_TEXTURE_2D_ARRAY:
+    case GL_TEXTURE_CUBE_MAP_ARRAY:
+        texture->storage3D(key.levels, key.internalformat, key.width, key.height, key.depth, src_loc);
+        break;
+    default:
+        texture->storage2D(key.levels, key.internalformat, key.width, key.height, src_loc);
+        break;
+    }
+    return texture;
+}
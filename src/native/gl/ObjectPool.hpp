@@ -0,0 +1,182 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "native/gl/Buffer.hpp"
+#include "native/gl/Sync.hpp"
+#include "native/gl/Texture.hpp"
+
+namespace nglpmt::native {
+
+// Recycles GL objects with equal immutable storage instead of deleting them.
+// Released object becomes available again after the GPU passed its fence.
+template<typename T, typename Key>
+class GlObjectPool : public SharedObject<GlObjectPool<T, Key>> {
+public:
+    static std::shared_ptr<GlObjectPool> make(const std::shared_ptr<Context>& ctx);
+    virtual ~GlObjectPool(){};
+
+    std::shared_ptr<T> acquire(const Key& key,
+                               const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    size_t getIdleCount() const;
+    size_t getPendingCount() const;
+
+    // Drops idle objects, pending ones are dropped once signaled
+    void clear();
+
+protected:
+    GlObjectPool(const std::shared_ptr<Context>& ctx);
+
+private:
+    struct Pending {
+        Key key;
+        std::shared_ptr<T> object;
+        std::shared_ptr<GlSync> fence;
+        // Set by clear(), object is deleted instead of becoming idle
+        bool dropped = false;
+    };
+
+    const std::weak_ptr<Context> _wctx;
+    mutable std::mutex _lock;
+    std::multimap<Key, std::shared_ptr<T>> _idle;
+    std::vector<Pending> _pending;
+
+    std::shared_ptr<T> _wrap(const Key& key, const std::shared_ptr<T>& object);
+    void _release(const Key& key, const std::shared_ptr<T>& object);
+    // context thread
+    void _update();
+
+    static std::shared_ptr<T> _create(const std::shared_ptr<Context>& ctx,
+                                      const Key& key,
+                                      const Val<const SrcLoc>& src_loc);
+};
+
+struct GlBufferPoolKey {
+    SizeiPtr size;
+    BitField flags;
+
+    auto operator<=>(const GlBufferPoolKey&) const = default;
+};
+
+struct GlTexturePoolKey {
+    Enum type;
+    Sizei levels;
+    Enum internalformat;
+    Sizei width;
+    Sizei height = 1;
+    Sizei depth = 1;
+
+    auto operator<=>(const GlTexturePoolKey&) const = default;
+};
+
+using GlBufferPool = GlObjectPool<GlBuffer, GlBufferPoolKey>;
+using GlTexturePool = GlObjectPool<GlTexture, GlTexturePoolKey>;
+
+template<>
+std::shared_ptr<GlBuffer> GlBufferPool::_create(const std::shared_ptr<Context>& ctx,
+                                                const GlBufferPoolKey& key,
+                                                const Val<const SrcLoc>& src_loc);
+
+template<>
+std::shared_ptr<GlTexture> GlTexturePool::_create(const std::shared_ptr<Context>& ctx,
+                                                  const GlTexturePoolKey& key,
+                                                  const Val<const SrcLoc>& src_loc);
+
+template<typename T, typename Key>
+inline std::shared_ptr<GlObjectPool<T, Key>> GlObjectPool<T, Key>::make(const std::shared_ptr<Context>& ctx){
+    auto self = std::shared_ptr<GlObjectPool>(new GlObjectPool(ctx));
+    ctx->onRun->addActionQueued([wself = std::weak_ptr<GlObjectPool>(self)](){
+        auto self = wself.lock();
+        if (!self){
+            return false;
+        }
+        self->_update();
+        return true;
+    });
+    return self;
+}
+
+template<typename T, typename Key>
+inline GlObjectPool<T, Key>::GlObjectPool(const std::shared_ptr<Context>& ctx) :
+    _wctx(ctx){
+}
+
+template<typename T, typename Key>
+inline std::shared_ptr<T> GlObjectPool<T, Key>::acquire(const Key& key,
+                                                        const Val<const SrcLoc>& src_loc){
+    {
+        std::lock_guard lg(_lock);
+        auto iter = _idle.find(key);
+        if (iter != _idle.end()){
+            auto object = iter->second;
+            _idle.erase(iter);
+            return _wrap(key, object);
+        }
+    }
+
+    auto ctx = _wctx.lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+    return _wrap(key, _create(ctx, key, src_loc));
+}
+
+template<typename T, typename Key>
+inline size_t GlObjectPool<T, Key>::getIdleCount() const {
+    std::lock_guard lg(_lock);
+    return _idle.size();
+}
+
+template<typename T, typename Key>
+inline size_t GlObjectPool<T, Key>::getPendingCount() const {
+    std::lock_guard lg(_lock);
+    return _pending.size();
+}
+
+template<typename T, typename Key>
+inline void GlObjectPool<T, Key>::clear(){
+    std::lock_guard lg(_lock);
+    _idle.clear();
+    for (auto& pending : _pending){
+        pending.dropped = true;
+    }
+}
+
+template<typename T, typename Key>
+inline std::shared_ptr<T> GlObjectPool<T, Key>::_wrap(const Key& key, const std::shared_ptr<T>& object){
+    // Object itself stays owned by pool, user gets a handle returning it back on release
+    return std::shared_ptr<T>(object.get(), [wself = this->weak_from_this(), key, object](T*){
+        auto self = wself.lock();
+        if (self){
+            self->_release(key, object);
+        }
+    });
+}
+
+template<typename T, typename Key>
+inline void GlObjectPool<T, Key>::_release(const Key& key, const std::shared_ptr<T>& object){
+    auto ctx = _wctx.lock();
+    if (!ctx){
+        return;
+    }
+    // Fence goes to the queue after every command already issued for the object
+    auto fence = GlSync::make(ctx);
+
+    std::lock_guard lg(_lock);
+    _pending.push_back(Pending{key, object, fence});
+}
+
+template<typename T, typename Key>
+inline void GlObjectPool<T, Key>::_update(){
+    std::lock_guard lg(_lock);
+    GlSync::retireSignaled(_pending, [this](const Pending& pending){
+        if (!pending.dropped){
+            _idle.emplace(pending.key, pending.object);
+        }
+    });
+}
+
+} // namespace nglpmt::native
@@ -1,5 +1,7 @@
 #include "native/gl/Program.hpp"
 
+#include <algorithm>
+
 #include "glad/gl.h"
 
 using namespace nglpmt::native;
@@ -87,15 +89,85 @@ void GlProgram::getUniformLocation(const Val<Int>& dst,
                                    const Val<const std::string>& name,
                                    const Val<const SrcLoc>& src_loc) const {
     if (movedToContext<&GlProgram::getUniformLocation>(dst, name, src_loc)){return;}
+    auto info = findUniform(GlUniformName(*name));
+    if (info){
+        *dst = info->location;
+        return;
+    }
+    // Names missing from reflection cache are still resolved by driver
     *dst = glGetUniformLocation(id(), name->c_str());
     debug(src_loc);
 }
 
+void GlProgram::getUniformInfo(const Val<GlUniformInfo>& dst,
+                               const Val<const GlUniformName>& name,
+                               const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlProgram::getUniformInfo>(dst, name, src_loc)){return;}
+    auto info = findUniform(*name);
+    *dst = info ? *info : GlUniformInfo{-1, 0, 0};
+}
+
+const GlUniformInfo* GlProgram::findUniform(const GlUniformName& name) const {
+    auto iter = std::lower_bound(_uniforms.begin(), _uniforms.end(), name.hash,
+                                 [](const auto& entry, const UInt64& hash){return entry.first < hash;});
+    if (iter == _uniforms.end() || iter->first != name.hash){
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+std::future<GlBlockLayout> GlProgram::getBlockLayout(const Val<const GlUniformName>& name,
+                                                     const Val<const SrcLoc>& src_loc) const {
+    auto promise = std::make_shared<std::promise<GlBlockLayout>>();
+    auto future = promise->get_future();
+    _getBlockLayout(promise, name, src_loc);
+    return future;
+}
+
+void GlProgram::_getBlockLayout(const std::shared_ptr<std::promise<GlBlockLayout>>& promise,
+                                const Val<const GlUniformName>& name,
+                                const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlProgram::_getBlockLayout>(promise, name, src_loc)){return;}
+    auto block = findBlock(*name);
+    if (!block){
+        // Thrown inside onRun action it would be lost, caller gets it from future
+        promise->set_exception(std::make_exception_ptr(std::invalid_argument("GlProgram: block is not active")));
+        return;
+    }
+    promise->set_value(*block);
+}
+
+const GlBlockLayout* GlProgram::findBlock(const GlUniformName& name) const {
+    for (auto& block : _blocks){
+        if (block.hash == name.hash){
+            return &block;
+        }
+    }
+    return nullptr;
+}
+
+void GlProgram::setBlockBinding(const Val<const GlUniformName>& name,
+                                const Val<const UInt>& binding,
+                                const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlProgram::setBlockBinding>(name, binding, src_loc)){return;}
+    auto block = std::find_if(_blocks.begin(), _blocks.end(), [&name](const auto& block){return block.hash == name->hash;});
+    if (block == _blocks.end()){
+        return;
+    }
+    if (block->is_storage){
+        glShaderStorageBlockBinding(id(), block->index, binding);
+    } else {
+        glUniformBlockBinding(id(), block->index, binding);
+    }
+    debug(src_loc);
+    block->binding = *binding;
+}
+
 void GlProgram::getUniformBlockIndex(const Val<UInt>& dst,
                                      const Val<const std::string>& name,
                                      const Val<const SrcLoc>& src_loc) const {
     if (movedToContext<&GlProgram::getUniformBlockIndex>(dst, name, src_loc)){return;}
-    glGetUniformBlockIndex(id(), name->c_str());
+    *dst = glGetUniformBlockIndex(id(), name->c_str());
     debug(src_loc);
 }
 
@@ -108,10 +180,60 @@ void GlProgram::attach(const Val<const GlShader>& shader,
 
 void GlProgram::link(const Val<const SrcLoc>& src_loc) {
     if (movedToContext<&GlProgram::link>(src_loc)){return;}
-    glLinkProgram(id());
+    _linkNow(src_loc);
+    _reflect();
+}
+
+std::future<bool> GlProgram::linkAsync(const Val<const SrcLoc>& src_loc){
+    auto ctx = getContext().lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+
+    // Reflection reads link status, it waits for completion
+    auto self = shared_from_this();
+    return _whenCompleted(ctx, [self, src_loc](){
+        self->_linkNow(src_loc);
+    }, [self](const Enum& pname){
+        Int value = GL_FALSE;
+        glGetProgramiv(self->id(), pname, &value);
+        return value;
+    }, GL_LINK_STATUS, [self](){
+        self->_reflect();
+    }, src_loc);
+}
+
+void GlProgram::setParameteri(const Val<const Enum>& pname,
+                              const Val<const Int>& value,
+                              const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlProgram::setParameteri>(pname, value, src_loc)){return;}
+    glProgramParameteri(id(), pname, value);
+    debug(src_loc);
+}
+
+void GlProgram::getBinary(const Val<Enum>& format,
+                          const Val<std::vector<UByte>>& binary,
+                          const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlProgram::getBinary>(format, binary, src_loc)){return;}
+    Int length = 0;
+    glGetProgramiv(id(), GL_PROGRAM_BINARY_LENGTH, &length);
+    binary->resize(length);
+    glGetProgramBinary(id(), length, &length, format, binary->data());
+    binary->resize(length);
     debug(src_loc);
 }
 
+void GlProgram::binary(const Val<const Enum>& format,
+                       const Val<const std::vector<UByte>>& binary,
+                       const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlProgram::binary>(format, binary, src_loc)){return;}
+    // Values are reset like by linking
+    _uniform_values.clear();
+    glProgramBinary(id(), format, binary->data(), static_cast<Sizei>(binary->size()));
+    debug(src_loc);
+    _reflect();
+}
+
 void GlProgram::validate(const Val<const SrcLoc>& src_loc) const {
     if (movedToContext<&GlProgram::validate>(src_loc)){return;}
     glValidateProgram(id());
@@ -129,6 +251,8 @@ void GlProgram::uniform1f(const Val<const Int>& location,
                           const Val<const Float>& v0,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1f>(location, v0, src_loc)){return;}
+    const Float values[] = {*v0};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform1f(id(), location, v0);
     debug(src_loc);
 }
@@ -138,6 +262,8 @@ void GlProgram::uniform2f(const Val<const Int>& location,
                           const Val<const Float>& v1,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2f>(location, v0, v1, src_loc)){return;}
+    const Float values[] = {*v0, *v1};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform2f(id(), location, v0, v1);
     debug(src_loc);
 }
@@ -148,6 +274,8 @@ void GlProgram::uniform3f(const Val<const Int>& location,
                           const Val<const Float>& v2,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3f>(location, v0, v1, v2, src_loc)){return;}
+    const Float values[] = {*v0, *v1, *v2};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform3f(id(), location, v0, v1, v2);
     debug(src_loc);
 }
@@ -159,6 +287,8 @@ void GlProgram::uniform4f(const Val<const Int>& location,
                           const Val<const Float>& v3,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4f>(location, v0, v1, v2, v3, src_loc)){return;}
+    const Float values[] = {*v0, *v1, *v2, *v3};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform4f(id(), location, v0, v1, v2, v3);
     debug(src_loc);
 }
@@ -168,6 +298,7 @@ void GlProgram::uniform1fv(const Val<const Int>& location,
                            const Val<const Float[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1fv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 1 * sizeof(Float))){return;}
     glProgramUniform1fv(id(), location, count, data);
     debug(src_loc);
 }
@@ -177,6 +308,7 @@ void GlProgram::uniform2fv(const Val<const Int>& location,
                            const Val<const Float[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2fv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 2 * sizeof(Float))){return;}
     glProgramUniform2fv(id(), location, count, data);
     debug(src_loc);
 }
@@ -186,6 +318,7 @@ void GlProgram::uniform3fv(const Val<const Int>& location,
                            const Val<const Float[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3fv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 3 * sizeof(Float))){return;}
     glProgramUniform3fv(id(), location, count, data);
     debug(src_loc);
 }
@@ -195,6 +328,7 @@ void GlProgram::uniform4fv(const Val<const Int>& location,
                            const Val<const Float[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4fv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 4 * sizeof(Float))){return;}
     glProgramUniform4fv(id(), location, count, data);
     debug(src_loc);
 }
@@ -205,6 +339,11 @@ void GlProgram::uniformMatrix2fv(const Val<const Int>& location,
                                  const Val<const Float[]>& data,
                                  const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix2fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 4 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix2fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -215,6 +354,11 @@ void GlProgram::uniformMatrix2x3fv(const Val<const Int>& location,
                                    const Val<const Float[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix2x3fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 6 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix2x3fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -225,6 +369,11 @@ void GlProgram::uniformMatrix2x4fv(const Val<const Int>& location,
                                    const Val<const Float[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix2x4fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 8 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix2x4fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -235,6 +384,11 @@ void GlProgram::uniformMatrix3fv(const Val<const Int>& location,
                                  const Val<const Float[]>& data,
                                  const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix3fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 9 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix3fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -245,6 +399,11 @@ void GlProgram::uniformMatrix3x2fv(const Val<const Int>& location,
                                    const Val<const Float[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix3x2fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 6 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix3x2fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -255,6 +414,11 @@ void GlProgram::uniformMatrix3x4fv(const Val<const Int>& location,
                                    const Val<const Float[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix3x4fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 12 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix3x4fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -265,6 +429,11 @@ void GlProgram::uniformMatrix4fv(const Val<const Int>& location,
                                  const Val<const Float[]>& data,
                                  const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix4fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 16 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix4fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -275,6 +444,11 @@ void GlProgram::uniformMatrix4x2fv(const Val<const Int>& location,
                                    const Val<const Float[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix4x2fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 8 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix4x2fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -285,6 +459,11 @@ void GlProgram::uniformMatrix4x3fv(const Val<const Int>& location,
                                    const Val<const Float[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix4x3fv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 12 * sizeof(Float))){
+        return;
+    }
     glProgramUniformMatrix4x3fv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -293,6 +472,8 @@ void GlProgram::uniform1d(const Val<const Int>& location,
                           const Val<const Double>& v0,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1d>(location, v0, src_loc)){return;}
+    const Double values[] = {*v0};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform1d(id(), location, v0);
     debug(src_loc);
 }
@@ -302,6 +483,8 @@ void GlProgram::uniform2d(const Val<const Int>& location,
                           const Val<const Double>& v1,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2d>(location, v0, v1, src_loc)){return;}
+    const Double values[] = {*v0, *v1};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform2d(id(), location, v0, v1);
     debug(src_loc);
 }
@@ -312,6 +495,8 @@ void GlProgram::uniform3d(const Val<const Int>& location,
                           const Val<const Double>& v2,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3d>(location, v0, v1, v2, src_loc)){return;}
+    const Double values[] = {*v0, *v1, *v2};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform3d(id(), location, v0, v1, v2);
     debug(src_loc);
 }
@@ -323,6 +508,8 @@ void GlProgram::uniform4d(const Val<const Int>& location,
                           const Val<const Double>& v3,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4d>(location, v0, v1, v2, v3, src_loc)){return;}
+    const Double values[] = {*v0, *v1, *v2, *v3};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform4d(id(), location, v0, v1, v2, v3);
     debug(src_loc);
 }
@@ -332,6 +519,7 @@ void GlProgram::uniform1dv(const Val<const Int>& location,
                            const Val<const Double[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1dv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 1 * sizeof(Double))){return;}
     glProgramUniform1dv(id(), location, count, data);
     debug(src_loc);
 }
@@ -341,6 +529,7 @@ void GlProgram::uniform2dv(const Val<const Int>& location,
                            const Val<const Double[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2dv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 2 * sizeof(Double))){return;}
     glProgramUniform2dv(id(), location, count, data);
     debug(src_loc);
 }
@@ -350,6 +539,7 @@ void GlProgram::uniform3dv(const Val<const Int>& location,
                            const Val<const Double[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3dv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 3 * sizeof(Double))){return;}
     glProgramUniform3dv(id(), location, count, data);
     debug(src_loc);
 }
@@ -359,6 +549,7 @@ void GlProgram::uniform4dv(const Val<const Int>& location,
                            const Val<const Double[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4dv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 4 * sizeof(Double))){return;}
     glProgramUniform4dv(id(), location, count, data);
     debug(src_loc);
 }
@@ -369,6 +560,11 @@ void GlProgram::uniformMatrix2dv(const Val<const Int>& location,
                                  const Val<const Double[]>& data,
                                  const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix2dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 4 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix2dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -379,6 +575,11 @@ void GlProgram::uniformMatrix2x3dv(const Val<const Int>& location,
                                    const Val<const Double[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix2x3dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 6 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix2x3dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -389,6 +590,11 @@ void GlProgram::uniformMatrix2x4dv(const Val<const Int>& location,
                                    const Val<const Double[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix2x4dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 8 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix2x4dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -399,6 +605,11 @@ void GlProgram::uniformMatrix3dv(const Val<const Int>& location,
                                  const Val<const Double[]>& data,
                                  const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix3dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 9 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix3dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -409,6 +620,11 @@ void GlProgram::uniformMatrix3x2dv(const Val<const Int>& location,
                                    const Val<const Double[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix3x2dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 6 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix3x2dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -419,6 +635,11 @@ void GlProgram::uniformMatrix3x4dv(const Val<const Int>& location,
                                    const Val<const Double[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix3x4dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 12 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix3x4dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -429,6 +650,11 @@ void GlProgram::uniformMatrix4dv(const Val<const Int>& location,
                                  const Val<const Double[]>& data,
                                  const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix4dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 16 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix4dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -439,6 +665,11 @@ void GlProgram::uniformMatrix4x2dv(const Val<const Int>& location,
                                    const Val<const Double[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix4x2dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 8 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix4x2dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -449,6 +680,11 @@ void GlProgram::uniformMatrix4x3dv(const Val<const Int>& location,
                                    const Val<const Double[]>& data,
                                    const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniformMatrix4x3dv>(location, count, transpose, data, src_loc)){return;}
+    if (*transpose){
+        _forgetUniform(*location, *count);
+    } else if (_isSameUniform(*location, *count, data.get().get(), *count * 12 * sizeof(Double))){
+        return;
+    }
     glProgramUniformMatrix4x3dv(id(), location, count, transpose, data);
     debug(src_loc);
 }
@@ -457,6 +693,8 @@ void GlProgram::uniform1i(const Val<const Int>& location,
                           const Val<const Int>& v0,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1i>(location, v0, src_loc)){return;}
+    const Int values[] = {*v0};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform1i(id(), location, v0);
     debug(src_loc);
 }
@@ -466,6 +704,8 @@ void GlProgram::uniform2i(const Val<const Int>& location,
                           const Val<const Int>& v1,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2i>(location, v0, v1, src_loc)){return;}
+    const Int values[] = {*v0, *v1};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform2i(id(), location, v0, v1);
     debug(src_loc);
 }
@@ -476,6 +716,8 @@ void GlProgram::uniform3i(const Val<const Int>& location,
                           const Val<const Int>& v2,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3i>(location, v0, v1, v2, src_loc)){return;}
+    const Int values[] = {*v0, *v1, *v2};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform3i(id(), location, v0, v1, v2);
     debug(src_loc);
 }
@@ -487,6 +729,8 @@ void GlProgram::uniform4i(const Val<const Int>& location,
                           const Val<const Int>& v3,
                           const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4i>(location, v0, v1, v2, v3, src_loc)){return;}
+    const Int values[] = {*v0, *v1, *v2, *v3};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform4i(id(), location, v0, v1, v2, v3);
     debug(src_loc);
 }
@@ -496,6 +740,7 @@ void GlProgram::uniform1iv(const Val<const Int>& location,
                            const Val<const Int[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1iv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 1 * sizeof(Int))){return;}
     glProgramUniform1iv(id(), location, count, data);
     debug(src_loc);
 }
@@ -505,6 +750,7 @@ void GlProgram::uniform2iv(const Val<const Int>& location,
                            const Val<const Int[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2iv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 2 * sizeof(Int))){return;}
     glProgramUniform2iv(id(), location, count, data);
     debug(src_loc);
 }
@@ -514,6 +760,7 @@ void GlProgram::uniform3iv(const Val<const Int>& location,
                            const Val<const Int[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3iv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 3 * sizeof(Int))){return;}
     glProgramUniform3iv(id(), location, count, data);
     debug(src_loc);
 }
@@ -523,6 +770,7 @@ void GlProgram::uniform4iv(const Val<const Int>& location,
                            const Val<const Int[]>& data,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4iv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 4 * sizeof(Int))){return;}
     glProgramUniform4iv(id(), location, count, data);
     debug(src_loc);
 }
@@ -531,6 +779,8 @@ void GlProgram::uniform1ui(const Val<const Int>& location,
                            const Val<const UInt>& v0,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1ui>(location, v0, src_loc)){return;}
+    const UInt values[] = {*v0};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform1ui(id(), location, v0);
     debug(src_loc);
 }
@@ -540,6 +790,8 @@ void GlProgram::uniform2ui(const Val<const Int>& location,
                            const Val<const UInt>& v1,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2ui>(location, v0, v1, src_loc)){return;}
+    const UInt values[] = {*v0, *v1};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform2ui(id(), location, v0, v1);
     debug(src_loc);
 }
@@ -550,6 +802,8 @@ void GlProgram::uniform3ui(const Val<const Int>& location,
                            const Val<const UInt>& v2,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3ui>(location, v0, v1, v2, src_loc)){return;}
+    const UInt values[] = {*v0, *v1, *v2};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform3ui(id(), location, v0, v1, v2);
     debug(src_loc);
 }
@@ -561,6 +815,8 @@ void GlProgram::uniform4ui(const Val<const Int>& location,
                            const Val<const UInt>& v3,
                            const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4ui>(location, v0, v1, v2, v3, src_loc)){return;}
+    const UInt values[] = {*v0, *v1, *v2, *v3};
+    if (_isSameUniform(*location, 1, values, sizeof(values))){return;}
     glProgramUniform4ui(id(), location, v0, v1, v2, v3);
     debug(src_loc);
 }
@@ -570,6 +826,7 @@ void GlProgram::uniform1uiv(const Val<const Int>& location,
                             const Val<const UInt[]>& data,
                             const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform1uiv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 1 * sizeof(UInt))){return;}
     glProgramUniform1uiv(id(), location, count, data);
     debug(src_loc);
 }
@@ -579,6 +836,7 @@ void GlProgram::uniform2uiv(const Val<const Int>& location,
                             const Val<const UInt[]>& data,
                             const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform2uiv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 2 * sizeof(UInt))){return;}
     glProgramUniform2uiv(id(), location, count, data);
     debug(src_loc);
 }
@@ -588,6 +846,7 @@ void GlProgram::uniform3uiv(const Val<const Int>& location,
                             const Val<const UInt[]>& data,
                             const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform3uiv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 3 * sizeof(UInt))){return;}
     glProgramUniform3uiv(id(), location, count, data);
     debug(src_loc);
 }
@@ -597,10 +856,254 @@ void GlProgram::uniform4uiv(const Val<const Int>& location,
                             const Val<const UInt[]>& data,
                             const Val<const SrcLoc>& src_loc){
     if (movedToContext<&GlProgram::uniform4uiv>(location, count, data, src_loc)){return;}
+    if (_isSameUniform(*location, *count, data.get().get(), *count * 4 * sizeof(UInt))){return;}
     glProgramUniform4uiv(id(), location, count, data);
     debug(src_loc);
 }
 
+GlUniformStats GlProgram::getUniformStats() const {
+    return GlUniformStats{_uniform_calls.load(), _uniform_skips.load()};
+}
+
+void GlProgram::resetUniformStats(){
+    _uniform_calls = 0;
+    _uniform_skips = 0;
+}
+
+bool GlProgram::_isSameUniform(const Int& location,
+                               const Sizei& count,
+                               const void* data,
+                               const size_t& bytes){
+    ++_uniform_calls;
+    if (location < 0 || count <= 0){
+        return false;
+    }
+
+    // Every array element has own location
+    auto element = static_cast<const UByte*>(data);
+    size_t element_size = bytes / count;
+    bool same = true;
+    for (Sizei i = 0; i < count; ++i, element += element_size){
+        size_t loc = location + i;
+        if (loc >= _uniform_values.size()){
+            same = false;
+            continue;
+        }
+        auto& value = _uniform_values[loc];
+        if (value.size() == element_size && std::equal(value.begin(), value.end(), element)){
+            continue;
+        }
+        same = false;
+        value.assign(element, element + element_size);
+    }
+
+    if (same){
+        ++_uniform_skips;
+    }
+    return same;
+}
+
+void GlProgram::_forgetUniform(const Int& location, const Sizei& count){
+    ++_uniform_calls;
+    for (Sizei i = 0; i < count; ++i){
+        size_t loc = location + i;
+        if (location >= 0 && loc < _uniform_values.size()){
+            _uniform_values[loc].clear();
+        }
+    }
+}
+
+void GlProgram::_linkNow(const Val<const SrcLoc>& src_loc){
+    // Values are reset by linking, setters issued before reflection of
+    // async link must not be skipped
+    _uniform_values.clear();
+    glLinkProgram(id());
+    debug(src_loc);
+}
+
+void GlProgram::_reflect(){
+    _reflectUniforms();
+    _blocks.clear();
+    _reflectBlocks(GL_UNIFORM_BLOCK);
+    _reflectBlocks(GL_SHADER_STORAGE_BLOCK);
+}
+
+void GlProgram::_reflectUniforms(){
+    _uniforms.clear();
+
+    Int linked = GL_FALSE;
+    glGetProgramiv(id(), GL_LINK_STATUS, &linked);
+    if (!linked){
+        return;
+    }
+
+    Int count = 0;
+    glGetProgramInterfaceiv(id(), GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+    static const Enum props[] = {GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE, GL_NAME_LENGTH};
+    std::string name;
+    for (Int i = 0; i < count; ++i){
+        Int values[4];
+        glGetProgramResourceiv(id(), GL_UNIFORM, i, 4, props, 4, nullptr, values);
+        // Block members have no location
+        if (values[0] < 0){
+            continue;
+        }
+
+        name.resize(values[3]);
+        Sizei length = 0;
+        glGetProgramResourceName(id(), GL_UNIFORM, i, values[3], &length, name.data());
+        std::string_view view(name.data(), length);
+
+        GlUniformInfo info{values[0], static_cast<Enum>(values[1]), values[2]};
+        _uniform_values.resize(std::max(_uniform_values.size(), static_cast<size_t>(info.location + info.size)));
+        _uniforms.emplace_back(GlUniformName(view).hash, info);
+        // Arrays are reported as "name[0]", plain "name" and "name[N]" are
+        // accepted too, elements of basic type arrays have consecutive locations
+        if (view.ends_with("[0]")){
+            auto base = view.substr(0, view.size() - 3);
+            _uniforms.emplace_back(GlUniformName(base).hash, info);
+            for (Int element = 1; element < info.size; ++element){
+                auto element_name = std::string(base) + "[" + std::to_string(element) + "]";
+                _uniforms.emplace_back(GlUniformName(element_name).hash,
+                                       GlUniformInfo{info.location + element, info.type, info.size - element});
+            }
+        }
+    }
+    std::sort(_uniforms.begin(), _uniforms.end(),
+              [](const auto& a, const auto& b){return a.first < b.first;});
+}
+
+void GlProgram::_reflectBlocks(const Enum& interface){
+    Int linked = GL_FALSE;
+    glGetProgramiv(id(), GL_LINK_STATUS, &linked);
+    if (!linked){
+        return;
+    }
+
+    bool is_storage = interface == GL_SHADER_STORAGE_BLOCK;
+    Enum member_interface = is_storage ? GL_BUFFER_VARIABLE : GL_UNIFORM;
+    static const Enum block_props[] = {GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES, GL_NAME_LENGTH};
+    static const Enum member_props[] = {GL_TYPE, GL_OFFSET, GL_ARRAY_SIZE, GL_ARRAY_STRIDE,
+                                        GL_MATRIX_STRIDE, GL_IS_ROW_MAJOR, GL_NAME_LENGTH};
+    static const Enum active_variables = GL_ACTIVE_VARIABLES;
+
+    Int count = 0;
+    glGetProgramInterfaceiv(id(), interface, GL_ACTIVE_RESOURCES, &count);
+    for (Int i = 0; i < count; ++i){
+        Int values[4];
+        glGetProgramResourceiv(id(), interface, i, 4, block_props, 4, nullptr, values);
+
+        GlBlockLayout block{};
+        block.is_storage = is_storage;
+        block.index = i;
+        block.binding = values[0];
+        block.size = values[1];
+        block.name.resize(values[3]);
+        Sizei length = 0;
+        glGetProgramResourceName(id(), interface, i, values[3], &length, block.name.data());
+        block.name.resize(length);
+        block.hash = GlUniformName(block.name).hash;
+
+        std::vector<Int> indices(values[2]);
+        glGetProgramResourceiv(id(), interface, i, 1, &active_variables, values[2], nullptr, indices.data());
+        for (auto index : indices){
+            Int member_values[7];
+            glGetProgramResourceiv(id(), member_interface, index, 7, member_props, 7, nullptr, member_values);
+
+            GlBlockMember member{};
+            member.type = static_cast<Enum>(member_values[0]);
+            member.offset = member_values[1];
+            member.array_size = member_values[2];
+            member.array_stride = member_values[3];
+            member.matrix_stride = member_values[4];
+            member.row_major = member_values[5] != 0;
+            member.name.resize(member_values[6]);
+            glGetProgramResourceName(id(), member_interface, index, member_values[6], &length, member.name.data());
+            member.name.resize(length);
+            // Instance blocks report "Block.member", arrays "member[0]"
+            if (member.name.starts_with(block.name + ".")){
+                member.name.erase(0, block.name.size() + 1);
+            }
+            if (member.name.ends_with("[0]")){
+                member.name.resize(member.name.size() - 3);
+            }
+            member.hash = GlUniformName(member.name).hash;
+            block.members.push_back(std::move(member));
+        }
+        std::sort(block.members.begin(), block.members.end(),
+                  [](const auto& a, const auto& b){return a.offset < b.offset;});
+        _blocks.push_back(std::move(block));
+    }
+}
+
+const GlBlockMember* GlBlockLayout::findMember(const GlUniformName& name) const {
+    for (auto& member : members){
+        if (member.hash == name.hash){
+            return &member;
+        }
+    }
+    return nullptr;
+}
+
+void GlBlockLayout::validate(const std::vector<GlBlockMemberDecl>& expected) const {
+    std::string errors;
+    for (auto& decl : expected){
+        auto member = findMember(GlUniformName(decl.name));
+        if (!member){
+            errors += " " + decl.name + " is not active;";
+        } else if (member->type != decl.type){
+            errors += " " + decl.name + " has type " + std::to_string(member->type) + ";";
+        } else if (member->offset != decl.offset){
+            errors += " " + decl.name + " has offset " + std::to_string(member->offset) + ";";
+        } else if (member->array_stride != decl.array_stride){
+            errors += " " + decl.name + " has array stride " + std::to_string(member->array_stride) + ";";
+        } else if (member->matrix_stride != decl.matrix_stride){
+            errors += " " + decl.name + " has matrix stride " + std::to_string(member->matrix_stride) + ";";
+        } else if (member->row_major != decl.row_major){
+            errors += " " + decl.name + (member->row_major ? " is row major;" : " is column major;");
+        }
+    }
+    if (!errors.empty()){
+        throw std::invalid_argument("GlBlockLayout " + name + ":" + errors);
+    }
+}
+
+GlTypeShape GlTypeShape::of(const Enum& type){
+    switch (type){
+        case GL_FLOAT: return {4, 1, 1};
+        case GL_FLOAT_VEC2: return {4, 2, 1};
+        case GL_FLOAT_VEC3: return {4, 3, 1};
+        case GL_FLOAT_VEC4: return {4, 4, 1};
+        case GL_DOUBLE: return {8, 1, 1};
+        case GL_DOUBLE_VEC2: return {8, 2, 1};
+        case GL_DOUBLE_VEC3: return {8, 3, 1};
+        case GL_DOUBLE_VEC4: return {8, 4, 1};
+        case GL_INT: case GL_UNSIGNED_INT: case GL_BOOL: return {4, 1, 1};
+        case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: case GL_BOOL_VEC2: return {4, 2, 1};
+        case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: case GL_BOOL_VEC3: return {4, 3, 1};
+        case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: case GL_BOOL_VEC4: return {4, 4, 1};
+        case GL_FLOAT_MAT2: return {4, 2, 2};
+        case GL_FLOAT_MAT3: return {4, 3, 3};
+        case GL_FLOAT_MAT4: return {4, 4, 4};
+        case GL_FLOAT_MAT2x3: return {4, 3, 2};
+        case GL_FLOAT_MAT2x4: return {4, 4, 2};
+        case GL_FLOAT_MAT3x2: return {4, 2, 3};
+        case GL_FLOAT_MAT3x4: return {4, 4, 3};
+        case GL_FLOAT_MAT4x2: return {4, 2, 4};
+        case GL_FLOAT_MAT4x3: return {4, 3, 4};
+        case GL_DOUBLE_MAT2: return {8, 2, 2};
+        case GL_DOUBLE_MAT3: return {8, 3, 3};
+        case GL_DOUBLE_MAT4: return {8, 4, 4};
+        case GL_DOUBLE_MAT2x3: return {8, 3, 2};
+        case GL_DOUBLE_MAT2x4: return {8, 4, 2};
+        case GL_DOUBLE_MAT3x2: return {8, 2, 3};
+        case GL_DOUBLE_MAT3x4: return {8, 4, 3};
+        case GL_DOUBLE_MAT4x2: return {8, 2, 4};
+        case GL_DOUBLE_MAT4x3: return {8, 3, 4};
+        default: return {0, 0, 0};
+    }
+}
+
 void GlProgram::_initer(const Val<UInt>& dst,
                       const Val<const SrcLoc>& src_loc){
     *dst = glCreateProgram();
@@ -1,10 +1,85 @@
 #pragma once
 
+#include <atomic>
+#include <future>
+#include <string_view>
+#include <vector>
+
 #include "native/gl/Object.hpp"
 #include "native/gl/Shader.hpp"
 
 namespace nglpmt::native {
 
+// Pre-hashed uniform name, FNV-1a. Hash literals once, e.g.
+// static constexpr GlUniformName u_color("u_color");
+struct GlUniformName {
+    UInt64 hash;
+
+    constexpr GlUniformName(std::string_view name) : hash(0xcbf29ce484222325ull){
+        for (char c : name){
+            hash = (hash ^ static_cast<UByte>(c)) * 0x100000001b3ull;
+        }
+    }
+    constexpr GlUniformName(const char* name) : GlUniformName(std::string_view(name)){}
+};
+
+struct GlUniformInfo {
+    Int location;
+    Enum type;
+    Int size;
+};
+
+struct GlBlockMember {
+    std::string name;
+    UInt64 hash;
+    Enum type;
+    Int offset;
+    Int array_size;
+    Int array_stride;
+    Int matrix_stride;
+    bool row_major;
+};
+
+// Expected member for GlBlockLayout::validate
+struct GlBlockMemberDecl {
+    std::string name;
+    Enum type;
+    Int offset;
+    // Zero and false for non-array and non-matrix members, as reflected
+    Int array_stride = 0;
+    Int matrix_stride = 0;
+    bool row_major = false;
+};
+
+// Uniform block or shader storage block as laid out by the driver
+struct GlBlockLayout {
+    std::string name;
+    UInt64 hash;
+    bool is_storage;
+    UInt index;
+    Int binding;
+    Int size;
+    std::vector<GlBlockMember> members;
+
+    const GlBlockMember* findMember(const GlUniformName& name) const;
+    // Throws std::invalid_argument listing every mismatch
+    void validate(const std::vector<GlBlockMemberDecl>& expected) const;
+};
+
+// Component size, rows and columns of GLSL type, zeros for opaque types
+struct GlTypeShape {
+    Int component_size;
+    Int rows;
+    Int columns;
+
+    static GlTypeShape of(const Enum& type);
+};
+
+struct GlUniformStats {
+    UInt64 calls;
+    UInt64 skipped;
+};
+
 class GlProgram : public GlObject<GlProgram> {
 public:
     static std::shared_ptr<GlProgram> make(const std::shared_ptr<Context>& ctx,
@@ -50,11 +125,42 @@ public:
                                const Val<const std::string>& name,
                                const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
 
-    // glGetUniformLocation
+    // Reflection cache first, glGetUniformLocation on miss
     void getUniformLocation(const Val<Int>& dst,
                             const Val<const std::string>& name,
                             const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
 
+    // Resolved from reflection cache when program is linked
+    void getUniformInfo(const Val<GlUniformInfo>& dst,
+                        const Val<const GlUniformName>& name,
+                        const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // Context thread only. Returns nullptr for inactive or unknown uniforms
+    const GlUniformInfo* findUniform(const GlUniformName& name) const;
+
+    // Calls location based setter M with location resolved from reflection
+    // cache, e.g. uniform<&GlProgram::uniform4f>("u_color", r, g, b, a).
+    template<auto M, typename... Args>
+    void uniform(const Val<const GlUniformName>& name,
+                 const Args&... args);
+
+    // Setters skip GL call when value equals the last one set at the location
+    GlUniformStats getUniformStats() const;
+    void resetUniformStats();
+
+    // Uniform and shader storage blocks reflected at link. Future holds
+    // std::invalid_argument when block is not active
+    std::future<GlBlockLayout> getBlockLayout(const Val<const GlUniformName>& name,
+                                              const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // Context thread only. Returns nullptr for unknown blocks
+    const GlBlockLayout* findBlock(const GlUniformName& name) const;
+
+    // glUniformBlockBinding or glShaderStorageBlockBinding
+    void setBlockBinding(const Val<const GlUniformName>& name,
+                         const Val<const UInt>& binding,
+                         const Val<const SrcLoc>& src_loc = SrcLoc{});
+
     // glGetUniformBlockIndex
     void getUniformBlockIndex(const Val<UInt>& dst,
                               const Val<const std::string>& name,
@@ -67,6 +173,24 @@ public:
     // glLinkProgram
     void link(const Val<const SrcLoc>& src_loc = SrcLoc{});
 
+    // glLinkProgram without blocking context thread, resolves to GL_LINK_STATUS
+    std::future<bool> linkAsync(const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glProgramParameteri
+    void setParameteri(const Val<const Enum>& pname,
+                       const Val<const Int>& value,
+                       const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glGetProgramBinary
+    void getBinary(const Val<Enum>& format,
+                   const Val<std::vector<UByte>>& binary,
+                   const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glProgramBinary
+    void binary(const Val<const Enum>& format,
+                const Val<const std::vector<UByte>>& binary,
+                const Val<const SrcLoc>& src_loc = SrcLoc{});
+
     // glValidateProgram
     void validate(const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
 
@@ -404,9 +528,50 @@ protected:
             const Val<const SrcLoc>& src_loc);
 
 private:
+    // Active uniforms sorted by name hash, rebuilt on every link
+    std::vector<std::pair<UInt64, GlUniformInfo>> _uniforms;
+
+    // Last value set at every reflected location, empty when unknown
+    std::vector<std::vector<UByte>> _uniform_values;
+    std::atomic<UInt64> _uniform_calls = 0;
+    std::atomic<UInt64> _uniform_skips = 0;
+
+    std::vector<GlBlockLayout> _blocks;
+
+    // glLinkProgram without reflection, context thread
+    void _linkNow(const Val<const SrcLoc>& src_loc);
+    // glGetProgramResourceiv
+    void _reflect();
+    void _reflectUniforms();
+    void _reflectBlocks(const Enum& interface);
+    void _getBlockLayout(const std::shared_ptr<std::promise<GlBlockLayout>>& promise,
+                         const Val<const GlUniformName>& name,
+                         const Val<const SrcLoc>& src_loc) const;
+    // Compares with shadow and stores the value, context thread
+    bool _isSameUniform(const Int& location,
+                        const Sizei& count,
+                        const void* data,
+                        const size_t& bytes);
+    void _forgetUniform(const Int& location, const Sizei& count);
+
     static void _initer(const Val<UInt>& dst,
                         const Val<const SrcLoc>& src_loc);
     static void _deleter(const UInt& id);
 };
 
+template<auto M, typename... Args>
+inline void GlProgram::uniform(const Val<const GlUniformName>& name,
+                               const Args&... args){
+    if (movedToContext<&GlProgram::uniform<M, Args...>>(name, args...)){return;}
+    auto info = findUniform(*name);
+    if (!info){
+        return;
+    }
+    if constexpr (std::is_invocable_v<decltype(M), GlProgram*, Val<const Int>, const Args&...>){
+        std::invoke(M, this, Val<const Int>(info->location), args...);
+    } else {
+        std::invoke(M, this, Val<const Int>(info->location), args..., Val<const SrcLoc>(SrcLoc{}));
+    }
+}
+
 } // namespace glwpp
\ No newline at end of file
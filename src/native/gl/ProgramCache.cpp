@@ -0,0 +1,185 @@
+#include "native/gl/ProgramCache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+namespace {
+    // FNV-1a, stable between runs unlike std::hash
+    UInt64 hashBytes(UInt64 hash, const void* data, size_t size){
+        auto bytes = static_cast<const UByte*>(data);
+        for (size_t i = 0; i < size; ++i){
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    UInt64 hashString(UInt64 hash, const char* str){
+        return str ? hashBytes(hash, str, std::strlen(str) + 1) : hash;
+    }
+}
+
+std::shared_ptr<GlProgramCache> GlProgramCache::make(const std::shared_ptr<Context>& ctx,
+                                                     const Val<const std::string>& dir){
+    return std::shared_ptr<GlProgramCache>(new GlProgramCache(ctx, *dir));
+}
+
+GlProgramCache::GlProgramCache(const std::shared_ptr<Context>& ctx,
+                               const std::string& dir) :
+    ContextObject(ctx),
+    _dir(dir){
+}
+
+GlProgramCache::~GlProgramCache(){
+}
+
+std::shared_ptr<GlProgram> GlProgramCache::build(const Val<const std::vector<GlProgramSource>>& sources,
+                                                 const Val<const SrcLoc>& src_loc){
+    auto ctx = getContext().lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+    auto program = GlProgram::make(ctx, src_loc);
+    _build(program, sources, src_loc);
+    return program;
+}
+
+GlProgramCacheStats GlProgramCache::getStats() const {
+    return GlProgramCacheStats{_hits.load(), _misses.load(), _rejected.load()};
+}
+
+void GlProgramCache::_build(const Val<GlProgram>& program,
+                            const Val<const std::vector<GlProgramSource>>& sources,
+                            const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlProgramCache::_build>(program, sources, src_loc)){return;}
+    _init();
+    if (!_supported){
+        ++_misses;
+        _compile(program.get(), *sources, src_loc);
+        return;
+    }
+
+    UInt64 hash = _driver_hash;
+    for (auto& source : *sources){
+        hash = hashBytes(hash, &source.type, sizeof(source.type));
+        hash = hashBytes(hash, source.code.data(), source.code.size() + 1);
+    }
+    std::stringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    auto path = _dir / name.str();
+
+    if (_load(program.get(), path, src_loc)){
+        ++_hits;
+        return;
+    }
+    ++_misses;
+    _compile(program.get(), *sources, src_loc);
+    _store(program.get(), path, src_loc);
+}
+
+void GlProgramCache::_init(){
+    if (_initialized){
+        return;
+    }
+    _initialized = true;
+
+    Int formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    _supported = formats > 0;
+
+    UInt64 hash = 0xcbf29ce484222325ull;
+    for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION}){
+        hash = hashString(hash, reinterpret_cast<const char*>(glGetString(name)));
+    }
+    _driver_hash = hash;
+
+    std::error_code err;
+    std::filesystem::create_directories(_dir, err);
+}
+
+bool GlProgramCache::_load(const std::shared_ptr<GlProgram>& program,
+                           const std::filesystem::path& path,
+                           const Val<const SrcLoc>& src_loc){
+    std::ifstream file(path, std::ios::binary);
+    if (!file){
+        return false;
+    }
+
+    Enum format = 0;
+    if (!file.read(reinterpret_cast<char*>(&format), sizeof(format))){
+        return false;
+    }
+    std::vector<UByte> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.empty()){
+        return false;
+    }
+
+    program->binary(format, data, src_loc);
+    Int linked = GL_FALSE;
+    glGetProgramiv(program->id(), GL_LINK_STATUS, &linked);
+    if (!linked){
+        ++_rejected;
+        std::error_code err;
+        std::filesystem::remove(path, err);
+        return false;
+    }
+    return true;
+}
+
+void GlProgramCache::_compile(const std::shared_ptr<GlProgram>& program,
+                              const std::vector<GlProgramSource>& sources,
+                              const Val<const SrcLoc>& src_loc){
+    auto ctx = getContext().lock();
+    if (!ctx){
+        return;
+    }
+
+    for (auto& source : sources){
+        auto shader = GlShader::make(ctx, source.type, src_loc);
+        shader->source(source.code, src_loc);
+        shader->compile(src_loc);
+        program->attach(shader, src_loc);
+    }
+    program->setParameteri(GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE, src_loc);
+    program->link(src_loc);
+}
+
+void GlProgramCache::_store(const std::shared_ptr<GlProgram>& program,
+                            const std::filesystem::path& path,
+                            const Val<const SrcLoc>& src_loc){
+    Int linked = GL_FALSE;
+    glGetProgramiv(program->id(), GL_LINK_STATUS, &linked);
+    if (!linked){
+        return;
+    }
+
+    Val<Enum> format(0);
+    Val<std::vector<UByte>> data(std::vector<UByte>{});
+    program->getBinary(format, data, src_loc);
+    if (data->empty()){
+        return;
+    }
+
+    // Cache is optional, failed write only costs next start
+    auto tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file){
+            return;
+        }
+        Enum value = *format;
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        file.write(reinterpret_cast<const char*>(data->data()), data->size());
+        if (!file){
+            return;
+        }
+    }
+    std::error_code err;
+    std::filesystem::rename(tmp, path, err);
+}
\ No newline at end of file
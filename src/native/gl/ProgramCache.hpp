@@ -0,0 +1,65 @@
+#pragma once
+
+#include <filesystem>
+
+#include "native/gl/Program.hpp"
+
+namespace nglpmt::native {
+
+struct GlProgramSource {
+    Enum type;
+    std::string code;
+};
+
+struct GlProgramCacheStats {
+    UInt64 hits;
+    UInt64 misses;
+    // Binaries refused by driver, e.g. after driver update
+    UInt64 rejected;
+};
+
+// Stores linked program binaries on disk. Key is hash of shader sources and
+// driver strings, so binaries of another driver are never even tried.
+class GlProgramCache : public ContextObject<GlProgramCache>, public GlObjectStatic {
+public:
+    static std::shared_ptr<GlProgramCache> make(const std::shared_ptr<Context>& ctx,
+                                                const Val<const std::string>& dir);
+    virtual ~GlProgramCache();
+
+    // Loads binary or compiles and links sources when there is no valid binary
+    std::shared_ptr<GlProgram> build(const Val<const std::vector<GlProgramSource>>& sources,
+                                     const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    GlProgramCacheStats getStats() const;
+
+protected:
+    GlProgramCache(const std::shared_ptr<Context>& ctx,
+                   const std::string& dir);
+
+private:
+    const std::filesystem::path _dir;
+    UInt64 _driver_hash = 0;
+    bool _supported = false;
+    bool _initialized = false;
+
+    std::atomic<UInt64> _hits = 0;
+    std::atomic<UInt64> _misses = 0;
+    std::atomic<UInt64> _rejected = 0;
+
+    // context thread
+    void _build(const Val<GlProgram>& program,
+                const Val<const std::vector<GlProgramSource>>& sources,
+                const Val<const SrcLoc>& src_loc);
+    void _init();
+    bool _load(const std::shared_ptr<GlProgram>& program,
+               const std::filesystem::path& path,
+               const Val<const SrcLoc>& src_loc);
+    void _compile(const std::shared_ptr<GlProgram>& program,
+                  const std::vector<GlProgramSource>& sources,
+                  const Val<const SrcLoc>& src_loc);
+    void _store(const std::shared_ptr<GlProgram>& program,
+                const std::filesystem::path& path,
+                const Val<const SrcLoc>& src_loc);
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
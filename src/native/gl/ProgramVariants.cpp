@@ -0,0 +1,119 @@
+#include "native/gl/ProgramVariants.hpp"
+
+#include <algorithm>
+
+using namespace nglpmt::native;
+
+GlProgramVariants::State GlProgramVariants::Variant::getState() const {
+    if (linked.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+        return State::Pending;
+    }
+    return linked.get() ? State::Ready : State::Failed;
+}
+
+std::shared_ptr<GlProgramVariants> GlProgramVariants::make(const std::shared_ptr<Context>& ctx){
+    return std::shared_ptr<GlProgramVariants>(new GlProgramVariants(ctx));
+}
+
+GlProgramVariants::GlProgramVariants(const std::shared_ptr<Context>& ctx) :
+    _wctx(ctx){
+}
+
+GlProgramVariants::~GlProgramVariants(){
+}
+
+std::shared_ptr<const GlProgramVariants::Variant> GlProgramVariants::get(const std::vector<GlProgramSource>& sources,
+                                                                         const Defines& defines,
+                                                                         const Val<const SrcLoc>& src_loc){
+    auto ctx = _wctx.lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+
+    // Sorted and deduplicated, so equal sets give equal code
+    auto sorted = defines;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b){return a.first < b.first;});
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const auto& a, const auto& b){return a.first == b.first;}), sorted.end());
+    std::string header;
+    for (auto& [name, value] : sorted){
+        header += "#define " + name + " " + value + "\n";
+    }
+
+    std::lock_guard lg(_lock);
+    std::vector<std::shared_ptr<GlShader>> shaders;
+    std::vector<const GlShader*> key;
+    for (auto& source : sources){
+        shaders.push_back(_getShader(ctx, source.type, _inject(source.code, header), src_loc));
+        key.push_back(shaders.back().get());
+    }
+
+    auto iter = _programs.find(key);
+    if (iter != _programs.end()){
+        return iter->second;
+    }
+
+    auto program = GlProgram::make(ctx, src_loc);
+    for (auto& shader : shaders){
+        program->attach(shader, src_loc);
+    }
+    auto variant = std::make_shared<Variant>(Variant{program, program->linkAsync(src_loc).share()});
+    _programs.emplace(std::move(key), variant);
+    return variant;
+}
+
+size_t GlProgramVariants::getShaderCount() const {
+    std::lock_guard lg(_lock);
+    return _shaders.size();
+}
+
+size_t GlProgramVariants::getProgramCount() const {
+    std::lock_guard lg(_lock);
+    return _programs.size();
+}
+
+std::shared_ptr<GlShader> GlProgramVariants::_getShader(const std::shared_ptr<Context>& ctx,
+                                                        const Enum& type,
+                                                        std::string&& code,
+                                                        const Val<const SrcLoc>& src_loc){
+    auto key = std::make_pair(type, std::move(code));
+    auto iter = _shaders.find(key);
+    if (iter != _shaders.end()){
+        return iter->second;
+    }
+
+    auto shader = GlShader::make(ctx, type, src_loc);
+    shader->source(key.second, src_loc);
+    // Status is observed through program link
+    shader->compile(src_loc);
+    _shaders.emplace(std::move(key), shader);
+    return shader;
+}
+
+std::string GlProgramVariants::_inject(const std::string& code, const std::string& defines){
+    if (defines.empty()){
+        return code;
+    }
+
+    // Defines have to follow #version line
+    size_t pos = 0;
+    auto version = code.find("#version");
+    if (version != std::string::npos){
+        auto eol = code.find('\n', version);
+        pos = eol == std::string::npos ? code.size() : eol + 1;
+    }
+    std::string result;
+    result.reserve(code.size() + defines.size() + 16);
+    result.append(code, 0, pos);
+    if (pos > 0 && result.back() != '\n'){
+        result += '\n';
+    }
+    result += defines;
+    if (result.back() != '\n'){
+        result += '\n';
+    }
+    // Compile errors keep line numbers of original source
+    auto line = std::count(code.begin(), code.begin() + pos, '\n') + 1;
+    result += "#line " + std::to_string(line) + "\n";
+    result.append(code, pos, std::string::npos);
+    return result;
+}
\ No newline at end of file
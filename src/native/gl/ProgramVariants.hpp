@@ -0,0 +1,59 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "native/gl/ProgramCache.hpp"
+
+namespace nglpmt::native {
+
+// Program permutations keyed by sources and #define set. Identical shader
+// stages are compiled once and shared between programs, compilation starts
+// on first request and never blocks the caller.
+class GlProgramVariants : public SharedObject<GlProgramVariants> {
+public:
+    using Defines = std::vector<std::pair<std::string, std::string>>;
+
+    enum class State {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    struct Variant {
+        std::shared_ptr<GlProgram> program;
+        std::shared_future<bool> linked;
+
+        State getState() const;
+    };
+
+    static std::shared_ptr<GlProgramVariants> make(const std::shared_ptr<Context>& ctx);
+    virtual ~GlProgramVariants();
+
+    // Any thread. Order of defines does not matter
+    std::shared_ptr<const Variant> get(const std::vector<GlProgramSource>& sources,
+                                       const Defines& defines = {},
+                                       const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    size_t getShaderCount() const;
+    size_t getProgramCount() const;
+
+protected:
+    GlProgramVariants(const std::shared_ptr<Context>& ctx);
+
+private:
+    const std::weak_ptr<Context> _wctx;
+
+    mutable std::mutex _lock;
+    std::map<std::pair<Enum, std::string>, std::shared_ptr<GlShader>> _shaders;
+    std::map<std::vector<const GlShader*>, std::shared_ptr<const Variant>> _programs;
+
+    std::shared_ptr<GlShader> _getShader(const std::shared_ptr<Context>& ctx,
+                                         const Enum& type,
+                                         std::string&& code,
+                                         const Val<const SrcLoc>& src_loc);
+
+    static std::string _inject(const std::string& code, const std::string& defines);
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
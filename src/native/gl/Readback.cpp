@@ -0,0 +1,148 @@
+#include "native/gl/Readback.hpp"
+
+#include <bit>
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+namespace {
+    // Staging sizes are rounded up so pooled buffers get reused across reads
+    static constexpr SizeiPtr min_staging_size = 4096;
+    static constexpr BitField staging_flags = GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT;
+}
+
+std::shared_ptr<GlReadback> GlReadback::make(const std::shared_ptr<Context>& ctx){
+    return std::shared_ptr<GlReadback>(new GlReadback(ctx));
+}
+
+GlReadback::GlReadback(const std::shared_ptr<Context>& ctx) :
+    ContextObject(ctx),
+    _staging(GlBufferPool::make(ctx)){
+}
+
+GlReadback::~GlReadback(){
+}
+
+std::future<GlReadback::Data> GlReadback::readBuffer(const Val<const GlBuffer>& buffer,
+                                                     const Val<const IntPtr>& offset,
+                                                     const Val<const SizeiPtr>& size,
+                                                     const Val<const SrcLoc>& src_loc){
+    auto promise = std::make_shared<std::promise<Data>>();
+    auto future = promise->get_future();
+    _copyBuffer(buffer, offset, size, _toPromise(promise), src_loc);
+    return future;
+}
+
+void GlReadback::readBuffer(const Val<const GlBuffer>& buffer,
+                            const Val<const IntPtr>& offset,
+                            const Val<const SizeiPtr>& size,
+                            const Val<const Callback>& callback,
+                            const Val<const SrcLoc>& src_loc){
+    _copyBuffer(buffer, offset, size, callback, src_loc);
+}
+
+std::future<GlReadback::Data> GlReadback::readTexture(const Val<const GlTexture>& texture,
+                                                      const Val<const Int>& level,
+                                                      const Val<const Int>& xoffset,
+                                                      const Val<const Int>& yoffset,
+                                                      const Val<const Int>& zoffset,
+                                                      const Val<const Sizei>& width,
+                                                      const Val<const Sizei>& height,
+                                                      const Val<const Sizei>& depth,
+                                                      const Val<const Enum>& format,
+                                                      const Val<const Enum>& type,
+                                                      const Val<const Sizei>& bufSize,
+                                                      const Val<const SrcLoc>& src_loc){
+    auto promise = std::make_shared<std::promise<Data>>();
+    auto future = promise->get_future();
+    _copyTexture(texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, bufSize, _toPromise(promise), src_loc);
+    return future;
+}
+
+void GlReadback::readTexture(const Val<const GlTexture>& texture,
+                             const Val<const Int>& level,
+                             const Val<const Int>& xoffset,
+                             const Val<const Int>& yoffset,
+                             const Val<const Int>& zoffset,
+                             const Val<const Sizei>& width,
+                             const Val<const Sizei>& height,
+                             const Val<const Sizei>& depth,
+                             const Val<const Enum>& format,
+                             const Val<const Enum>& type,
+                             const Val<const Sizei>& bufSize,
+                             const Val<const Callback>& callback,
+                             const Val<const SrcLoc>& src_loc){
+    _copyTexture(texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, bufSize, callback, src_loc);
+}
+
+void GlReadback::_copyBuffer(const Val<const GlBuffer>& buffer,
+                             const Val<const IntPtr>& offset,
+                             const Val<const SizeiPtr>& size,
+                             const Val<const Callback>& callback,
+                             const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlReadback::_copyBuffer>(buffer, offset, size, callback, src_loc)){return;}
+    auto staging = _acquireStaging(*size, src_loc);
+    glCopyNamedBufferSubData(buffer->id(), staging->id(), offset, 0, size);
+    debug(src_loc);
+    _fetch(staging, *size, *callback, src_loc);
+}
+
+void GlReadback::_copyTexture(const Val<const GlTexture>& texture,
+                              const Val<const Int>& level,
+                              const Val<const Int>& xoffset,
+                              const Val<const Int>& yoffset,
+                              const Val<const Int>& zoffset,
+                              const Val<const Sizei>& width,
+                              const Val<const Sizei>& height,
+                              const Val<const Sizei>& depth,
+                              const Val<const Enum>& format,
+                              const Val<const Enum>& type,
+                              const Val<const Sizei>& bufSize,
+                              const Val<const Callback>& callback,
+                              const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlReadback::_copyTexture>(texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, bufSize, callback, src_loc)){return;}
+    auto staging = _acquireStaging(*bufSize, src_loc);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, staging->id());
+    glGetTextureSubImage(texture->id(), level, xoffset, yoffset, zoffset, width, height, depth, format, type, bufSize, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    debug(src_loc);
+    _fetch(staging, *bufSize, *callback, src_loc);
+}
+
+std::shared_ptr<GlBuffer> GlReadback::_acquireStaging(const SizeiPtr& size, const Val<const SrcLoc>& src_loc){
+    SizeiPtr staging_size = std::max(min_staging_size, static_cast<SizeiPtr>(std::bit_ceil(static_cast<UInt64>(size))));
+    return _staging->acquire(GlBufferPoolKey{staging_size, staging_flags}, src_loc);
+}
+
+void GlReadback::_fetch(const std::shared_ptr<GlBuffer>& staging,
+                        const SizeiPtr& size,
+                        const Callback& callback,
+                        const Val<const SrcLoc>& src_loc){
+    auto ctx = getContext().lock();
+    if (!ctx){
+        return;
+    }
+
+    auto fence = GlSync::make(ctx, src_loc);
+    ctx->onRun->addActionQueued([staging, size, callback, fence, src_loc](){
+        Val<bool> signaled(false);
+        fence->isSignaled(signaled, src_loc);
+        if (!*signaled){
+            return true;
+        }
+
+        // GPU is done with the copy, fetching does not stall anymore
+        auto data = std::make_shared<std::vector<UByte>>(size);
+        glGetNamedBufferSubData(staging->id(), 0, size, data->data());
+        debug(src_loc);
+        callback(data);
+        return false;
+    });
+}
+
+Val<const GlReadback::Callback> GlReadback::_toPromise(const std::shared_ptr<std::promise<Data>>& promise){
+    return Callback([promise](const Data& data){
+        promise->set_value(data);
+    });
+}
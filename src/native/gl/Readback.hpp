@@ -0,0 +1,97 @@
+#pragma once
+
+#include <future>
+#include <vector>
+
+#include "native/gl/ObjectPool.hpp"
+
+namespace nglpmt::native {
+
+// Asynchronous GPU -> CPU reads. Data is copied to a staging buffer, fenced and
+// fetched once the fence is signaled, context thread never waits for the GPU.
+class GlReadback : public ContextObject<GlReadback>, public GlObjectStatic {
+public:
+    using Data = std::shared_ptr<std::vector<UByte>>;
+    // Called on context thread
+    using Callback = std::function<void(const Data&)>;
+
+    static std::shared_ptr<GlReadback> make(const std::shared_ptr<Context>& ctx);
+    virtual ~GlReadback();
+
+    // glCopyNamedBufferSubData
+    std::future<Data> readBuffer(const Val<const GlBuffer>& buffer,
+                                 const Val<const IntPtr>& offset,
+                                 const Val<const SizeiPtr>& size,
+                                 const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    void readBuffer(const Val<const GlBuffer>& buffer,
+                    const Val<const IntPtr>& offset,
+                    const Val<const SizeiPtr>& size,
+                    const Val<const Callback>& callback,
+                    const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glGetTextureSubImage to GL_PIXEL_PACK_BUFFER
+    std::future<Data> readTexture(const Val<const GlTexture>& texture,
+                                  const Val<const Int>& level,
+                                  const Val<const Int>& xoffset,
+                                  const Val<const Int>& yoffset,
+                                  const Val<const Int>& zoffset,
+                                  const Val<const Sizei>& width,
+                                  const Val<const Sizei>& height,
+                                  const Val<const Sizei>& depth,
+                                  const Val<const Enum>& format,
+                                  const Val<const Enum>& type,
+                                  const Val<const Sizei>& bufSize,
+                                  const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    void readTexture(const Val<const GlTexture>& texture,
+                     const Val<const Int>& level,
+                     const Val<const Int>& xoffset,
+                     const Val<const Int>& yoffset,
+                     const Val<const Int>& zoffset,
+                     const Val<const Sizei>& width,
+                     const Val<const Sizei>& height,
+                     const Val<const Sizei>& depth,
+                     const Val<const Enum>& format,
+                     const Val<const Enum>& type,
+                     const Val<const Sizei>& bufSize,
+                     const Val<const Callback>& callback,
+                     const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+protected:
+    GlReadback(const std::shared_ptr<Context>& ctx);
+
+private:
+    const std::shared_ptr<GlBufferPool> _staging;
+
+    void _copyBuffer(const Val<const GlBuffer>& buffer,
+                     const Val<const IntPtr>& offset,
+                     const Val<const SizeiPtr>& size,
+                     const Val<const Callback>& callback,
+                     const Val<const SrcLoc>& src_loc);
+
+    void _copyTexture(const Val<const GlTexture>& texture,
+                      const Val<const Int>& level,
+                      const Val<const Int>& xoffset,
+                      const Val<const Int>& yoffset,
+                      const Val<const Int>& zoffset,
+                      const Val<const Sizei>& width,
+                      const Val<const Sizei>& height,
+                      const Val<const Sizei>& depth,
+                      const Val<const Enum>& format,
+                      const Val<const Enum>& type,
+                      const Val<const Sizei>& bufSize,
+                      const Val<const Callback>& callback,
+                      const Val<const SrcLoc>& src_loc);
+
+    // context thread
+    std::shared_ptr<GlBuffer> _acquireStaging(const SizeiPtr& size, const Val<const SrcLoc>& src_loc);
+    void _fetch(const std::shared_ptr<GlBuffer>& staging,
+                const SizeiPtr& size,
+                const Callback& callback,
+                const Val<const SrcLoc>& src_loc);
+
+    static Val<const Callback> _toPromise(const std::shared_ptr<std::promise<Data>>& promise);
+};
+
+} // namespace nglpmt::native
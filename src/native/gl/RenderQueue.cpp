@@ -0,0 +1,147 @@
+#include "native/gl/RenderQueue.hpp"
+
+#include <numeric>
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+std::shared_ptr<GlRenderQueue> GlRenderQueue::make(const std::shared_ptr<Context>& ctx){
+    return std::shared_ptr<GlRenderQueue>(new GlRenderQueue(ctx));
+}
+
+GlRenderQueue::GlRenderQueue(const std::shared_ptr<Context>& ctx) :
+    ContextObject(ctx){
+}
+
+GlRenderQueue::~GlRenderQueue(){
+}
+
+void GlRenderQueue::submit(GlDrawPacket&& packet){
+    std::lock_guard lg(_lock);
+    _packets.push_back(std::move(packet));
+}
+
+void GlRenderQueue::submit(const GlDrawPacket& packet){
+    std::lock_guard lg(_lock);
+    _packets.push_back(packet);
+}
+
+void GlRenderQueue::flush(const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlRenderQueue::flush>(src_loc)){return;}
+
+    std::vector<GlDrawPacket> packets;
+    {
+        std::lock_guard lg(_lock);
+        packets.swap(_packets);
+        // Keeps capacity for next frame
+        _packets.reserve(packets.size());
+    }
+
+    _sort(packets);
+    GlRenderQueueStats stats{packets.size(), 0, 0};
+    std::vector<UInt> submitted(packets.size());
+    std::iota(submitted.begin(), submitted.end(), 0);
+    stats.changes_unsorted = _countChanges(packets, submitted.begin(), submitted.end());
+    stats.changes_sorted = _countChanges(packets, _order.begin(), _order.end());
+
+    const GlProgram* program = nullptr;
+    const GlVertexArray* vao = nullptr;
+    std::array<const GlTexture*, GlDrawPacket::max_textures> textures{};
+    for (auto index : _order){
+        auto& packet = packets[index];
+        if (packet.program && packet.program.get() != program){
+            program = packet.program.get();
+            packet.program->use(src_loc);
+        }
+        if (packet.vao && packet.vao.get() != vao){
+            vao = packet.vao.get();
+            packet.vao->bind(src_loc);
+        }
+        for (UInt unit = 0; unit < GlDrawPacket::max_textures; ++unit){
+            auto& texture = packet.textures[unit];
+            if (texture && texture.get() != textures[unit]){
+                textures[unit] = texture.get();
+                texture->bindUnit(unit, src_loc);
+            }
+        }
+        if (packet.type){
+            glDrawElementsInstancedBaseVertexBaseInstance(packet.mode, packet.count, packet.type,
+                                                          reinterpret_cast<const void*>(packet.offset),
+                                                          packet.instances, packet.base_vertex, packet.base_instance);
+        } else {
+            glDrawArraysInstancedBaseInstance(packet.mode, packet.first, packet.count,
+                                              packet.instances, packet.base_instance);
+        }
+    }
+    glBindVertexArray(0);
+    debug(src_loc);
+
+    std::lock_guard lg(_lock);
+    _stats = stats;
+}
+
+GlRenderQueueStats GlRenderQueue::getStats() const {
+    std::lock_guard lg(_lock);
+    return _stats;
+}
+
+void GlRenderQueue::_sort(const std::vector<GlDrawPacket>& packets){
+    size_t size = packets.size();
+    _keys.resize(size);
+    _order.resize(size);
+    _order_tmp.resize(size);
+    UInt64 differ = 0;
+    for (size_t i = 0; i < size; ++i){
+        _keys[i] = packets[i].key;
+        _order[i] = static_cast<UInt>(i);
+        differ |= _keys[i] ^ _keys[0];
+    }
+
+    // LSD radix sort by bytes, stable so equal keys keep submission order
+    for (UInt shift = 0; shift < 64; shift += 8){
+        // Byte is equal in every key, pass would not change order
+        if (((differ >> shift) & 0xFF) == 0){
+            continue;
+        }
+
+        std::array<size_t, 257> offsets{};
+        for (auto index : _order){
+            ++offsets[((_keys[index] >> shift) & 0xFF) + 1];
+        }
+        for (size_t i = 1; i < offsets.size(); ++i){
+            offsets[i] += offsets[i - 1];
+        }
+        for (auto index : _order){
+            _order_tmp[offsets[(_keys[index] >> shift) & 0xFF]++] = index;
+        }
+        _order.swap(_order_tmp);
+    }
+}
+
+template<typename It>
+UInt64 GlRenderQueue::_countChanges(const std::vector<GlDrawPacket>& packets, It begin, It end){
+    UInt64 changes = 0;
+    const GlProgram* program = nullptr;
+    const GlVertexArray* vao = nullptr;
+    std::array<const GlTexture*, GlDrawPacket::max_textures> textures{};
+    for (auto iter = begin; iter != end; ++iter){
+        auto& packet = packets[*iter];
+        if (packet.program && packet.program.get() != program){
+            program = packet.program.get();
+            ++changes;
+        }
+        if (packet.vao && packet.vao.get() != vao){
+            vao = packet.vao.get();
+            ++changes;
+        }
+        for (UInt unit = 0; unit < GlDrawPacket::max_textures; ++unit){
+            auto texture = packet.textures[unit].get();
+            if (texture && texture != textures[unit]){
+                textures[unit] = texture;
+                ++changes;
+            }
+        }
+    }
+    return changes;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+
+#include "native/gl/Program.hpp"
+#include "native/gl/Texture.hpp"
+#include "native/gl/VertexArray.hpp"
+
+namespace nglpmt::native {
+
+struct GlDrawPacket {
+    static constexpr UInt max_textures = 8;
+
+    // Higher fields change less often in sorted order
+    static constexpr UInt64 makeKey(const UInt& pass,
+                                    const UInt& program,
+                                    const UInt& material,
+                                    const UInt& depth){
+        return (static_cast<UInt64>(pass & 0xFF) << 56)
+             | (static_cast<UInt64>(program & 0xFFFF) << 40)
+             | (static_cast<UInt64>(material & 0xFFFF) << 24)
+             | static_cast<UInt64>(depth & 0xFFFFFF);
+    }
+
+    UInt64 key;
+    std::shared_ptr<GlProgram> program;
+    std::shared_ptr<GlVertexArray> vao;
+    // Bound to units by index, nullptr keeps unit untouched
+    std::array<std::shared_ptr<GlTexture>, max_textures> textures;
+    // glDrawElementsInstancedBaseVertexBaseInstance, or
+    // glDrawArraysInstancedBaseInstance when type is 0
+    Enum mode;
+    Sizei count;
+    Enum type;
+    // Bytes into element buffer for indexed draws
+    IntPtr offset = 0;
+    // First vertex for non-indexed draws
+    Int first = 0;
+    Sizei instances = 1;
+    Int base_vertex = 0;
+    UInt base_instance = 0;
+};
+
+struct GlRenderQueueStats {
+    UInt64 packets;
+    // Program, vertex array and texture switches in submission order
+    UInt64 changes_unsorted;
+    // Switches actually issued after sorting
+    UInt64 changes_sorted;
+};
+
+// Collects draw packets from any thread and emits them sorted by key,
+// skipping program, vertex array and texture binds that are already set.
+class GlRenderQueue : public ContextObject<GlRenderQueue>, public GlObjectStatic {
+public:
+    static std::shared_ptr<GlRenderQueue> make(const std::shared_ptr<Context>& ctx);
+    virtual ~GlRenderQueue();
+
+    // Any thread
+    void submit(GlDrawPacket&& packet);
+    void submit(const GlDrawPacket& packet);
+
+    // Sorts and draws every packet submitted before it runs on context
+    // thread, expected once per frame after scene submission.
+    void flush(const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // Stats of last flush
+    GlRenderQueueStats getStats() const;
+
+protected:
+    GlRenderQueue(const std::shared_ptr<Context>& ctx);
+
+private:
+    mutable std::mutex _lock;
+    std::vector<GlDrawPacket> _packets;
+    GlRenderQueueStats _stats{};
+
+    // Reused between frames
+    std::vector<UInt64> _keys;
+    std::vector<UInt> _order;
+    std::vector<UInt> _order_tmp;
+
+    void _sort(const std::vector<GlDrawPacket>& packets);
+    template<typename It>
+    static UInt64 _countChanges(const std::vector<GlDrawPacket>& packets, It begin, It end);
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
@@ -63,6 +63,22 @@ void GlShader::compile(const Val<const SrcLoc>& src_loc){
     debug(src_loc);
 }
 
+std::future<bool> GlShader::compileAsync(const Val<const SrcLoc>& src_loc){
+    auto ctx = getContext().lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+
+    auto self = shared_from_this();
+    return _whenCompleted(ctx, [self, src_loc](){
+        self->compile(src_loc);
+    }, [self](const Enum& pname){
+        Int value = GL_FALSE;
+        glGetShaderiv(self->id(), pname, &value);
+        return value;
+    }, GL_COMPILE_STATUS, nullptr, src_loc);
+}
+
 void GlShader::_initer(const Val<UInt>& dst,
                        const Val<const Enum>& type,
                        const Val<const SrcLoc>& src_loc){
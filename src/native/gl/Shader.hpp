@@ -1,5 +1,6 @@
 #pragma once
 
+#include <future>
 #include <string>
 
 #include "native/gl/Object.hpp"
@@ -37,6 +38,9 @@ public:
     // glCompileShader
     void compile(const Val<const SrcLoc>& src_loc = SrcLoc{});
 
+    // glCompileShader without blocking context thread, resolves to GL_COMPILE_STATUS
+    std::future<bool> compileAsync(const Val<const SrcLoc>& src_loc = SrcLoc{});
+
 protected:
     GlShader(const std::shared_ptr<Context>& ctx,
              const Val<const Enum>& type,
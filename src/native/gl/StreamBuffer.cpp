@@ -0,0 +1,122 @@
+#include "native/gl/StreamBuffer.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+namespace {
+    static constexpr BitField stream_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    // Max possible GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, keeps every segment start aligned
+    static constexpr SizeiPtr segment_alignment = 256;
+}
+
+std::shared_ptr<GlStreamBuffer> GlStreamBuffer::make(const std::shared_ptr<Context>& ctx,
+                                                     const Val<const SizeiPtr>& segment_size,
+                                                     const Val<const UInt>& segments,
+                                                     const Val<const SrcLoc>& src_loc){
+    if (*segments < 3){
+        throw std::invalid_argument("GlStreamBuffer needs at least three segments");
+    }
+
+    auto self = std::shared_ptr<GlStreamBuffer>(new GlStreamBuffer(ctx, *segment_size, *segments, src_loc));
+    if (self->isContextThread()){
+        self->_init(src_loc);
+    } else {
+        ctx->onRun->addActionQueued([self, src_loc](){
+            self->_init(src_loc);
+            return false;
+        });
+    }
+
+    ctx->onFinish->addActionQueued([wself = std::weak_ptr<GlStreamBuffer>(self)](){
+        auto self = wself.lock();
+        if (!self){
+            return false;
+        }
+        self->_advance();
+        return true;
+    });
+    return self;
+}
+
+GlStreamBuffer::GlStreamBuffer(const std::shared_ptr<Context>& ctx,
+                               const SizeiPtr& segment_size,
+                               const UInt& segments,
+                               const Val<const SrcLoc>& src_loc) :
+    GlBuffer(ctx, src_loc),
+    _segment_size((segment_size + segment_alignment - 1) / segment_alignment * segment_alignment),
+    _segments(segments),
+    _mapped(nullptr),
+    _data(nullptr),
+    _state(0),
+    _fences(segments){
+}
+
+GlStreamBuffer::~GlStreamBuffer(){
+}
+
+std::optional<GlStreamBuffer::Allocation> GlStreamBuffer::allocate(const SizeiPtr& size,
+                                                                   const SizeiPtr& alignment){
+    auto data = _data.load();
+    if (!data || size <= 0 || alignment <= 0 || size > _segment_size){
+        return std::nullopt;
+    }
+
+    UInt64 state = _state.load();
+    UInt64 segment;
+    SizeiPtr begin;
+    do {
+        segment = state >> _offset_bits;
+        SizeiPtr offset = static_cast<SizeiPtr>(state & _offset_mask);
+        begin = (offset + alignment - 1) / alignment * alignment;
+        if (begin + size > _segment_size){
+            return std::nullopt;
+        }
+    } while (!_state.compare_exchange_weak(state, (segment << _offset_bits) | static_cast<UInt64>(begin + size)));
+
+    IntPtr offset = segment * _segment_size + begin;
+    return Allocation{data + offset, offset, size};
+}
+
+bool GlStreamBuffer::isReady() const {
+    return _data.load() != nullptr;
+}
+
+SizeiPtr GlStreamBuffer::getSegmentSize() const {
+    return _segment_size;
+}
+
+UInt GlStreamBuffer::getSegments() const {
+    return _segments;
+}
+
+void GlStreamBuffer::_init(const Val<const SrcLoc>& src_loc){
+    static const Val<const void> empty(std::shared_ptr<const void>(nullptr));
+
+    SizeiPtr size = _segment_size * _segments;
+    storage(size, empty, stream_flags, src_loc);
+    mapRange(_mapped, 0, size, stream_flags, src_loc);
+    _data = static_cast<UByte*>(*_mapped);
+}
+
+void GlStreamBuffer::_advance(){
+    auto ctx = getContext().lock();
+    if (!ctx || !isReady()){
+        return;
+    }
+
+    // Consumers of the retired segment had this whole frame to run
+    if (_retired){
+        _fences[*_retired] = GlSync::make(ctx);
+    }
+
+    UInt current = static_cast<UInt>(_state.load() >> _offset_bits);
+    UInt next = (current + 1) % _segments;
+    if (_fences[next]){
+        // Throttles CPU when GPU is a whole ring behind
+        _fences[next]->blockUntilSignaled();
+        _fences[next].reset();
+    }
+    _retired = current;
+    _state = static_cast<UInt64>(next) << _offset_bits;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <optional>
+
+#include "native/gl/Buffer.hpp"
+#include "native/gl/Sync.hpp"
+
+namespace nglpmt::native {
+
+// Persistently mapped ring of per-frame segments. Producers write straight
+// into mapped memory from any thread. Consumers queued during the frame may
+// run in the next frame's onRun, so retired segment is fenced at the end of
+// the following frame and reused only after the GPU passed that fence.
+// Needs at least three segments: fenced late, current and a free one.
+class GlStreamBuffer : public GlBuffer {
+public:
+    struct Allocation {
+        void* data;
+        IntPtr offset;
+        SizeiPtr size;
+    };
+
+    static std::shared_ptr<GlStreamBuffer> make(const std::shared_ptr<Context>& ctx,
+                                                const Val<const SizeiPtr>& segment_size,
+                                                const Val<const UInt>& segments = 3,
+                                                const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlStreamBuffer();
+
+    // Any thread. Memory is writable until the end of current frame,
+    // commands reading it have to be queued within the same frame.
+    std::optional<Allocation> allocate(const SizeiPtr& size,
+                                       const SizeiPtr& alignment = 1);
+
+    bool isReady() const;
+    SizeiPtr getSegmentSize() const;
+    UInt getSegments() const;
+
+protected:
+    GlStreamBuffer(const std::shared_ptr<Context>& ctx,
+                   const SizeiPtr& segment_size,
+                   const UInt& segments,
+                   const Val<const SrcLoc>& src_loc);
+
+private:
+    // Segment index in high bits, offset inside segment in low bits
+    static constexpr UInt64 _offset_bits = 48;
+    static constexpr UInt64 _offset_mask = (UInt64(1) << _offset_bits) - 1;
+
+    const SizeiPtr _segment_size;
+    const UInt _segments;
+    Val<void*> _mapped;
+    std::atomic<UByte*> _data;
+    std::atomic<UInt64> _state;
+    std::vector<std::shared_ptr<GlSync>> _fences;
+    // context thread, segment waiting for its late consumers
+    std::optional<UInt> _retired;
+
+    // context thread
+    void _init(const Val<const SrcLoc>& src_loc);
+    void _advance();
+};
+
+} // namespace nglpmt::native
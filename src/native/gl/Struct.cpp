@@ -0,0 +1,9 @@
+#include "native/gl/Struct.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+BitField GlStructStatic::_flags(){
+    return GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
\ No newline at end of file
@@ -1,56 +1,185 @@
 #pragma once
 
+#include <cstring>
+
 #include "native/gl/Buffer.hpp"
+#include "native/gl/Sync.hpp"
+
+namespace nglpmt::native {
+
+class GlStructStatic {
+protected:
+    // Max possible GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    static constexpr SizeiPtr _slot_alignment = 256;
 
-namespace glwpp::gl {
+    static BitField _flags();
+};
 
+// Per-frame constants for uniform blocks. Keeps one copy per frame in flight
+// inside single persistently mapped buffer, copy is switched at the end of
+// frame and rewritten only after GPU passed its fence. Value written during
+// a frame is seen by every draw of that frame.
 template<typename T>
-class Struct : public GlBuffer {
+class GlStruct : public GlBuffer, public GlStructStatic {
 public:
-    static std::shared_ptr<Struct> make(const std::shared_ptr<Context>& ctx,
-                                        const Val<const T>& initial,
-                                        const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        auto self = std::shared_ptr<Struct>(new Struct(ctx, initial, src_loc));
-        self->storage(sizeof(T), Val<const void>(initial), _access, src_loc);
-        return self;
-    };
-
-    ~Struct(){};
-
-    bool get(const Val<T>& dst,
-             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) const {
-        if (movedToContext<&Struct::get>(dst, src_loc)){return;}
-
-        Val<T*> mapped;
-        map(mapped, BufferMapAccess::ReadOnly, src_loc);
-        *dst = *mapped;
-        unmap(true, src_loc);
-        return true;
+    static std::shared_ptr<GlStruct> make(const std::shared_ptr<Context>& ctx,
+                                          const Val<const T>& initial = T{},
+                                          const Val<const UInt>& frames = 3,
+                                          const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlStruct(){};
+
+    void get(const Val<T>& dst,
+             const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    void set(const Val<const T>& value,
+             const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glBindBufferRange with current frame copy
+    void bindUniform(const Val<const UInt>& index,
+                     const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // Offset of current frame copy, context thread
+    IntPtr getOffset() const;
+    SizeiPtr getStride() const;
+    UInt getFrames() const;
+
+protected:
+    GlStruct(const std::shared_ptr<Context>& ctx,
+             const T& initial,
+             const UInt& frames,
+             const Val<const SrcLoc>& src_loc);
+
+private:
+    // Hide parent's make
+    using GlBuffer::make;
+
+    static constexpr SizeiPtr _stride = (sizeof(T) + _slot_alignment - 1) / _slot_alignment * _slot_alignment;
+
+    const UInt _frames;
+    T _value;
+    UInt _slot;
+    Val<void*> _mapped;
+    UByte* _data;
+    std::vector<std::shared_ptr<GlSync>> _fences;
+
+    // context thread
+    void _init(const Val<const SrcLoc>& src_loc);
+    void _advance();
+};
+
+template<typename T>
+inline std::shared_ptr<GlStruct<T>> GlStruct<T>::make(const std::shared_ptr<Context>& ctx,
+                                                      const Val<const T>& initial,
+                                                      const Val<const UInt>& frames,
+                                                      const Val<const SrcLoc>& src_loc){
+    if (*frames == 0){
+        throw std::invalid_argument("GlStruct needs at least one frame");
     }
 
-    bool set(const Val<const T>& value,
-             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (movedToContext<&Struct::set>(value, src_loc)){return;}
+    auto self = std::shared_ptr<GlStruct>(new GlStruct(ctx, *initial, *frames, src_loc));
+    if (self->isContextThread()){
+        self->_init(src_loc);
+    } else {
+        ctx->onRun->addActionQueued([self, src_loc](){
+            self->_init(src_loc);
+            return false;
+        });
+    }
 
-        Val<void*> mapped(nullptr);
-        map(mapped, BufferMapAccess::ReadOnly, src_loc);
-        auto mapped_struct = mapped.cast_reinterpret<T*>();
-        **mapped_struct = *value;
-        unmap(true, src_loc);
+    ctx->onFinish->addActionQueued([wself = std::weak_ptr<GlStruct>(self)](){
+        auto self = wself.lock();
+        if (!self){
+            return false;
+        }
+        self->_advance();
         return true;
+    });
+    return self;
+}
+
+template<typename T>
+inline GlStruct<T>::GlStruct(const std::shared_ptr<Context>& ctx,
+                             const T& initial,
+                             const UInt& frames,
+                             const Val<const SrcLoc>& src_loc) :
+    GlBuffer(ctx, src_loc),
+    _frames(frames),
+    _value(initial),
+    _slot(0),
+    _mapped(nullptr),
+    _data(nullptr),
+    _fences(frames){
+}
+
+template<typename T>
+inline void GlStruct<T>::get(const Val<T>& dst,
+                             const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlStruct::get>(dst, src_loc)){return;}
+    *dst = _value;
+}
+
+template<typename T>
+inline void GlStruct<T>::set(const Val<const T>& value,
+                             const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlStruct::set>(value, src_loc)){return;}
+    _value = *value;
+    if (_data){
+        std::memcpy(_data + _slot * _stride, &_value, sizeof(T));
     }
+}
 
-protected:
-    Struct(const std::shared_ptr<Context>& ctx,
-           const Val<const T>& initial,
-           const Val<const utils::SrcLoc>& src_loc) :
-        Buffer(ctx, src_loc){
+template<typename T>
+inline void GlStruct<T>::bindUniform(const Val<const UInt>& index,
+                                     const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlStruct::bindUniform>(index, src_loc)){return;}
+    bindUniformRange(index, getOffset(), sizeof(T), src_loc);
+}
+
+template<typename T>
+inline IntPtr GlStruct<T>::getOffset() const {
+    return _slot * _stride;
+}
+
+template<typename T>
+inline SizeiPtr GlStruct<T>::getStride() const {
+    return _stride;
+}
+
+template<typename T>
+inline UInt GlStruct<T>::getFrames() const {
+    return _frames;
+}
+
+template<typename T>
+inline void GlStruct<T>::_init(const Val<const SrcLoc>& src_loc){
+    static const Val<const void> empty(std::shared_ptr<const void>(nullptr));
+
+    SizeiPtr size = _stride * _frames;
+    storage(size, empty, _flags(), src_loc);
+    mapRange(_mapped, 0, size, _flags(), src_loc);
+    _data = static_cast<UByte*>(*_mapped);
+    for (UInt i = 0; i < _frames; ++i){
+        std::memcpy(_data + i * _stride, &_value, sizeof(T));
     }
+}
 
-private:
+template<typename T>
+inline void GlStruct<T>::_advance(){
+    auto ctx = getContext().lock();
+    if (!ctx || !_data){
+        return;
+    }
 
-    static inline const Val<const UInt> _access = static_cast<Enum>(BufferStorageFlag::Read)
-                                                  | static_cast<Enum>(BufferStorageFlag::Write);
-};
+    _fences[_slot] = GlSync::make(ctx);
+    UInt next = (_slot + 1) % _frames;
+    if (_fences[next]){
+        // Frame copy is reused only after the GPU read it
+        _fences[next]->blockUntilSignaled();
+        _fences[next].reset();
+    }
+    // Value persists across frames until next set
+    std::memcpy(_data + next * _stride, &_value, sizeof(T));
+    _slot = next;
+}
 
-}
\ No newline at end of file
+} // namespace nglpmt::native
\ No newline at end of file
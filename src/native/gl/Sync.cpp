@@ -0,0 +1,118 @@
+#include "native/gl/Sync.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+std::shared_ptr<GlSync> GlSync::make(const std::shared_ptr<Context>& ctx,
+                                     const Val<const SrcLoc>& src_loc){
+    return std::shared_ptr<GlSync>(new GlSync(ctx, src_loc));
+}
+
+GlSync::GlSync(const std::shared_ptr<Context>& ctx,
+               const Val<const SrcLoc>& src_loc) :
+    ContextObject(ctx),
+    _sync(_make_sync(ctx)),
+    _signaled(false){
+    if (!isContextThread()){
+        ctx->onRun->addActionQueued([sync = _sync, src_loc](){
+            _initer(sync, src_loc);
+            return false;
+        });
+    } else {
+        _initer(_sync, src_loc);
+    }
+}
+
+GlSync::~GlSync(){
+}
+
+void GlSync::isSignaled(const Val<bool>& dst,
+                        const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlSync::isSignaled>(dst, src_loc)){return;}
+    if (!_signaled && *_sync){
+        // Null until queued initer has created the fence
+        Int status = GL_UNSIGNALED;
+        glGetSynciv(*_sync, GL_SYNC_STATUS, 1, nullptr, &status);
+        debug(src_loc);
+        _signaled = (status == GL_SIGNALED);
+    }
+    *dst = _signaled;
+}
+
+void GlSync::clientWait(const Val<Enum>& dst,
+                        const Val<const UInt64>& timeout,
+                        const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlSync::clientWait>(dst, timeout, src_loc)){return;}
+    *dst = glClientWaitSync(*_sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    debug(src_loc);
+    if (*dst == GL_ALREADY_SIGNALED || *dst == GL_CONDITION_SATISFIED){
+        _signaled = true;
+    }
+}
+
+void GlSync::wait(const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlSync::wait>(src_loc)){return;}
+    glWaitSync(*_sync, 0, GL_TIMEOUT_IGNORED);
+    debug(src_loc);
+}
+
+void GlSync::blockUntilSignaled(const Val<const SrcLoc>& src_loc) const {
+    if (_signaled || !*_sync){
+        return;
+    }
+    blockUntilSignaled(*_sync);
+    debug(src_loc);
+    _signaled = true;
+}
+
+void GlSync::blockUntilSignaled(const GLsync& sync){
+    GLenum status;
+    do {
+        status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    } while (status == GL_TIMEOUT_EXPIRED);
+}
+
+std::future<void> GlSync::whenSignaled(const Val<const SrcLoc>& src_loc) const {
+    auto ctx = getContext().lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+
+    auto promise = std::make_shared<std::promise<void>>();
+    ctx->onRun->addActionQueued([self = shared_from_this(), promise, src_loc](){
+        Val<bool> signaled(false);
+        self->isSignaled(signaled, src_loc);
+        if (*signaled){
+            promise->set_value();
+        }
+        return !*signaled;
+    });
+    return promise->get_future();
+}
+
+void GlSync::_initer(const Val<GLsync>& dst,
+                     const Val<const SrcLoc>& src_loc){
+    *dst = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    debug(src_loc);
+}
+
+std::shared_ptr<GLsync> GlSync::_make_sync(const std::shared_ptr<Context>& ctx){
+    return std::shared_ptr<GLsync>(new GLsync(nullptr), [wctx = std::weak_ptr<Context>(ctx)](GLsync* sync){
+        auto ctx = wctx.lock();
+        if (!ctx || *sync == nullptr){
+            delete sync;
+            return;
+        }
+
+        if (ctx->isContextThread()){
+            glDeleteSync(*sync);
+        } else {
+            ctx->onRun->addActionQueued([value = *sync](){
+                glDeleteSync(value);
+                return false;
+            });
+        }
+        delete sync;
+    });
+}
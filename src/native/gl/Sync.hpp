@@ -0,0 +1,70 @@
+#pragma once
+
+#include <future>
+#include <vector>
+
+#include "native/gl/Object.hpp"
+
+namespace nglpmt::native {
+
+class GlSync : public ContextObject<GlSync>, public GlObjectStatic {
+public:
+    // glFenceSync
+    static std::shared_ptr<GlSync> make(const std::shared_ptr<Context>& ctx,
+                                        const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlSync();
+
+    // glGetSynciv
+    void isSignaled(const Val<bool>& dst,
+                    const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glClientWaitSync
+    void clientWait(const Val<Enum>& dst,
+                    const Val<const UInt64>& timeout,
+                    const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glWaitSync
+    void wait(const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // Context thread. Blocks until the fence passes, used to throttle CPU
+    void blockUntilSignaled(const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+    // Same for raw sync current on calling thread, sync is not deleted
+    static void blockUntilSignaled(const GLsync& sync);
+
+    // Polls the fence once per frame on context thread, never blocks it
+    std::future<void> whenSignaled(const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // Context thread. Erases entries whose `fence` member has passed and
+    // calls retire for each of them, never blocks
+    template<typename Pending, typename F>
+    static void retireSignaled(std::vector<Pending>& pending, F&& retire);
+
+protected:
+    GlSync(const std::shared_ptr<Context>& ctx,
+           const Val<const SrcLoc>& src_loc);
+
+private:
+    Val<GLsync> _sync;
+    mutable std::atomic<bool> _signaled;
+
+    static void _initer(const Val<GLsync>& dst,
+                        const Val<const SrcLoc>& src_loc);
+
+    static std::shared_ptr<GLsync> _make_sync(const std::shared_ptr<Context>& ctx);
+};
+
+template<typename Pending, typename F>
+inline void GlSync::retireSignaled(std::vector<Pending>& pending, F&& retire){
+    Val<bool> signaled(false);
+    for (auto iter = pending.begin(); iter != pending.end();){
+        iter->fence->isSignaled(signaled);
+        if (!*signaled){
+            ++iter;
+            continue;
+        }
+        retire(*iter);
+        iter = pending.erase(iter);
+    }
+}
+
+} // namespace nglpmt::native
@@ -7,7 +7,7 @@ using namespace nglpmt::native;
 std::shared_ptr<GlTexture> GlTexture::make(const std::shared_ptr<Context>& ctx,
                                        const Val<const Enum>& type,
                                        const Val<const SrcLoc>& src_loc){
-    std::shared_ptr<GlTexture>(new GlTexture(ctx, type, src_loc));
+    return std::shared_ptr<GlTexture>(new GlTexture(ctx, type, src_loc));
 }
 
 GlTexture::GlTexture(const std::shared_ptr<Context>& ctx,
@@ -170,6 +170,42 @@ void GlTexture::setSubImage3D(const Val<const Int>& level,
     debug(src_loc);
 }
 
+void GlTexture::unpackSubImage2D(const Val<const Int>& level,
+                                 const Val<const Int>& xoffset,
+                                 const Val<const Int>& yoffset,
+                                 const Val<const Sizei>& width,
+                                 const Val<const Sizei>& height,
+                                 const Val<const Enum>& format,
+                                 const Val<const Enum>& type,
+                                 const Val<const GlBuffer>& buffer,
+                                 const Val<const IntPtr>& offset,
+                                 const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlTexture::unpackSubImage2D>(level, xoffset, yoffset, width, height, format, type, buffer, offset, src_loc)){return;}
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->id());
+    glTextureSubImage2D(id(), level, xoffset, yoffset, width, height, format, type, reinterpret_cast<const void*>(*offset));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    debug(src_loc);
+}
+
+void GlTexture::unpackSubImage3D(const Val<const Int>& level,
+                                 const Val<const Int>& xoffset,
+                                 const Val<const Int>& yoffset,
+                                 const Val<const Int>& zoffset,
+                                 const Val<const Sizei>& width,
+                                 const Val<const Sizei>& height,
+                                 const Val<const Sizei>& depth,
+                                 const Val<const Enum>& format,
+                                 const Val<const Enum>& type,
+                                 const Val<const GlBuffer>& buffer,
+                                 const Val<const IntPtr>& offset,
+                                 const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlTexture::unpackSubImage3D>(level, xoffset, yoffset, zoffset, width, height, depth, format, type, buffer, offset, src_loc)){return;}
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->id());
+    glTextureSubImage3D(id(), level, xoffset, yoffset, zoffset, width, height, depth, format, type, reinterpret_cast<const void*>(*offset));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    debug(src_loc);
+}
+
 void GlTexture::getParameteriv(const Val<const Enum>& pname,
                                const Val<Int[]>& params,
                                const Val<const SrcLoc>& src_loc) const {
@@ -123,6 +123,32 @@ public:
                        const Val<const void>& pixels,
                        const Val<const SrcLoc>& src_loc = SrcLoc{});
 
+    // glTextureSubImage2D from GL_PIXEL_UNPACK_BUFFER
+    void unpackSubImage2D(const Val<const Int>& level,
+                          const Val<const Int>& xoffset,
+                          const Val<const Int>& yoffset,
+                          const Val<const Sizei>& width,
+                          const Val<const Sizei>& height,
+                          const Val<const Enum>& format,
+                          const Val<const Enum>& type,
+                          const Val<const GlBuffer>& buffer,
+                          const Val<const IntPtr>& offset,
+                          const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // glTextureSubImage3D from GL_PIXEL_UNPACK_BUFFER
+    void unpackSubImage3D(const Val<const Int>& level,
+                          const Val<const Int>& xoffset,
+                          const Val<const Int>& yoffset,
+                          const Val<const Int>& zoffset,
+                          const Val<const Sizei>& width,
+                          const Val<const Sizei>& height,
+                          const Val<const Sizei>& depth,
+                          const Val<const Enum>& format,
+                          const Val<const Enum>& type,
+                          const Val<const GlBuffer>& buffer,
+                          const Val<const IntPtr>& offset,
+                          const Val<const SrcLoc>& src_loc = SrcLoc{});
+
     // glGetTextureParameteriv
     void getParameteriv(const Val<const Enum>& pname,
                         const Val<Int[]>& params,
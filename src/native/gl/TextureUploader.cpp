@@ -0,0 +1,119 @@
+#include "native/gl/TextureUploader.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+namespace {
+    static constexpr BitField staging_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
+
+std::shared_ptr<GlTextureUploader> GlTextureUploader::make(const std::shared_ptr<Context>& ctx,
+                                                           const Val<const SizeiPtr>& staging_size,
+                                                           const Val<const SizeiPtr>& frame_budget,
+                                                           const Val<const SrcLoc>& src_loc){
+    auto self = std::shared_ptr<GlTextureUploader>(new GlTextureUploader(ctx, *staging_size, *frame_budget, src_loc));
+    ctx->onRun->addActionQueued([wself = std::weak_ptr<GlTextureUploader>(self)](){
+        auto self = wself.lock();
+        if (!self){
+            return false;
+        }
+        self->_update();
+        return true;
+    });
+    return self;
+}
+
+GlTextureUploader::GlTextureUploader(const std::shared_ptr<Context>& ctx,
+                                     const SizeiPtr& staging_size,
+                                     const SizeiPtr& frame_budget,
+                                     const Val<const SrcLoc>& src_loc) :
+    _allocator(GlBufferAllocator::make(ctx, staging_size, staging_flags, 256, src_loc)),
+    _frame_budget(frame_budget){
+}
+
+GlTextureUploader::~GlTextureUploader(){
+}
+
+GlTextureUploader::Staging GlTextureUploader::stage(const SizeiPtr& size){
+    return _allocator->allocate(size);
+}
+
+void GlTextureUploader::upload2D(const std::shared_ptr<GlTexture>& texture,
+                                 const Int& level,
+                                 const Int& xoffset,
+                                 const Int& yoffset,
+                                 const Sizei& width,
+                                 const Sizei& height,
+                                 const Enum& format,
+                                 const Enum& type,
+                                 const Staging& staging,
+                                 const Val<const SrcLoc>& src_loc){
+    _push(Upload{texture, false, level, xoffset, yoffset, 0, width, height, 1, format, type, staging, src_loc});
+}
+
+void GlTextureUploader::upload3D(const std::shared_ptr<GlTexture>& texture,
+                                 const Int& level,
+                                 const Int& xoffset,
+                                 const Int& yoffset,
+                                 const Int& zoffset,
+                                 const Sizei& width,
+                                 const Sizei& height,
+                                 const Sizei& depth,
+                                 const Enum& format,
+                                 const Enum& type,
+                                 const Staging& staging,
+                                 const Val<const SrcLoc>& src_loc){
+    _push(Upload{texture, true, level, xoffset, yoffset, zoffset, width, height, depth, format, type, staging, src_loc});
+}
+
+void GlTextureUploader::setFrameBudget(const SizeiPtr& bytes){
+    _frame_budget = bytes;
+}
+
+SizeiPtr GlTextureUploader::getFrameBudget() const {
+    return _frame_budget;
+}
+
+size_t GlTextureUploader::getQueuedCount() const {
+    std::lock_guard lg(_lock);
+    return _queue.size();
+}
+
+void GlTextureUploader::_push(Upload&& upload){
+    if (!upload.texture || !upload.staging || upload.staging->buffer != _allocator->getBuffer()){
+        throw std::invalid_argument("GlTextureUploader: staging range is not owned by this uploader");
+    }
+
+    std::lock_guard lg(_lock);
+    _queue.push_back(std::move(upload));
+}
+
+void GlTextureUploader::_update(){
+    std::deque<Upload> ready;
+    {
+        std::lock_guard lg(_lock);
+        SizeiPtr budget = _frame_budget;
+        SizeiPtr used = 0;
+        // At least one upload per frame, otherwise a big one never fits
+        while (!_queue.empty() && (ready.empty() || used + _queue.front().staging->size <= budget)){
+            used += _queue.front().staging->size;
+            ready.push_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+    }
+
+    for (auto& upload : ready){
+        auto& range = *upload.staging;
+        if (upload.is_3d){
+            upload.texture->unpackSubImage3D(upload.level, upload.xoffset, upload.yoffset, upload.zoffset,
+                                             upload.width, upload.height, upload.depth,
+                                             upload.format, upload.type, range.buffer, range.offset, upload.src_loc);
+        } else {
+            upload.texture->unpackSubImage2D(upload.level, upload.xoffset, upload.yoffset,
+                                             upload.width, upload.height,
+                                             upload.format, upload.type, range.buffer, range.offset, upload.src_loc);
+        }
+    }
+    // Staging ranges are fenced by allocator when released here
+}
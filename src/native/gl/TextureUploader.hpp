@@ -0,0 +1,90 @@
+#pragma once
+
+#include <deque>
+
+#include "native/gl/BufferAllocator.hpp"
+#include "native/gl/Texture.hpp"
+
+namespace nglpmt::native {
+
+// Texture uploads through persistently mapped pixel unpack memory. Workers
+// write pixels straight into staged ranges, context thread only issues
+// glTextureSubImage* from the unpack buffer, limited by per-frame budget.
+class GlTextureUploader : public SharedObject<GlTextureUploader> {
+public:
+    using Staging = std::shared_ptr<const GlBufferAllocator::Range>;
+
+    static std::shared_ptr<GlTextureUploader> make(const std::shared_ptr<Context>& ctx,
+                                                   const Val<const SizeiPtr>& staging_size,
+                                                   const Val<const SizeiPtr>& frame_budget,
+                                                   const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlTextureUploader();
+
+    // Any thread. Returns nullptr while staging memory is exhausted or not mapped yet
+    Staging stage(const SizeiPtr& size);
+
+    // Any thread
+    void upload2D(const std::shared_ptr<GlTexture>& texture,
+                  const Int& level,
+                  const Int& xoffset,
+                  const Int& yoffset,
+                  const Sizei& width,
+                  const Sizei& height,
+                  const Enum& format,
+                  const Enum& type,
+                  const Staging& staging,
+                  const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    // Any thread
+    void upload3D(const std::shared_ptr<GlTexture>& texture,
+                  const Int& level,
+                  const Int& xoffset,
+                  const Int& yoffset,
+                  const Int& zoffset,
+                  const Sizei& width,
+                  const Sizei& height,
+                  const Sizei& depth,
+                  const Enum& format,
+                  const Enum& type,
+                  const Staging& staging,
+                  const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    void setFrameBudget(const SizeiPtr& bytes);
+    SizeiPtr getFrameBudget() const;
+    size_t getQueuedCount() const;
+
+protected:
+    GlTextureUploader(const std::shared_ptr<Context>& ctx,
+                      const SizeiPtr& staging_size,
+                      const SizeiPtr& frame_budget,
+                      const Val<const SrcLoc>& src_loc);
+
+private:
+    struct Upload {
+        std::shared_ptr<GlTexture> texture;
+        bool is_3d;
+        Int level;
+        Int xoffset;
+        Int yoffset;
+        Int zoffset;
+        Sizei width;
+        Sizei height;
+        Sizei depth;
+        Enum format;
+        Enum type;
+        Staging staging;
+        Val<const SrcLoc> src_loc;
+    };
+
+    const std::shared_ptr<GlBufferAllocator> _allocator;
+    std::atomic<SizeiPtr> _frame_budget;
+
+    mutable std::mutex _lock;
+    std::deque<Upload> _queue;
+
+    void _push(Upload&& upload);
+    // context thread
+    void _update();
+};
+
+} // namespace nglpmt::native
@@ -0,0 +1,30 @@
+#include "native/gl/Vector.hpp"
+
+#include "glad/gl.h"
+
+using namespace nglpmt::native;
+
+std::shared_ptr<GlBuffer> GlVectorStatic::_grow(const std::shared_ptr<Context>& ctx,
+                                                const std::shared_ptr<GlBuffer>& old,
+                                                const SizeiPtr& valid_bytes,
+                                                const SizeiPtr& new_bytes,
+                                                const Val<const SrcLoc>& src_loc){
+    static const Val<const void> empty(std::shared_ptr<const void>(nullptr));
+
+    auto buffer = GlBuffer::make(ctx, src_loc);
+    buffer->storage(new_bytes, empty, GL_DYNAMIC_STORAGE_BIT, src_loc);
+    if (old && valid_bytes > 0){
+        glCopyNamedBufferSubData(old->id(), buffer->id(), 0, 0, valid_bytes);
+        debug(src_loc);
+    }
+    return buffer;
+}
+
+void GlVectorStatic::_upload(const std::shared_ptr<GlBuffer>& buffer,
+                             const IntPtr& offset,
+                             const SizeiPtr& size,
+                             const void* data,
+                             const Val<const SrcLoc>& src_loc){
+    glNamedBufferSubData(buffer->id(), offset, size, data);
+    debug(src_loc);
+}
@@ -1,173 +1,291 @@
 #pragma once
 
-#include <optional>
+#include <algorithm>
+#include <mutex>
+#include <vector>
 
-#include "glwpp/gl/enums/BufferStorageFlag.hpp"
-#include "glwpp/gl/obj/Buffer.hpp"
+#include "native/gl/Buffer.hpp"
 
-namespace glwpp::gl {
+namespace nglpmt::native {
 
+class GlVectorStatic : public GlObjectStatic {
+protected:
+    // Creates bigger storage and moves valid bytes with one glCopyNamedBufferSubData
+    static std::shared_ptr<GlBuffer> _grow(const std::shared_ptr<Context>& ctx,
+                                           const std::shared_ptr<GlBuffer>& old,
+                                           const SizeiPtr& valid_bytes,
+                                           const SizeiPtr& new_bytes,
+                                           const Val<const SrcLoc>& src_loc);
+
+    // glNamedBufferSubData straight from CPU memory, context thread only
+    static void _upload(const std::shared_ptr<GlBuffer>& buffer,
+                        const IntPtr& offset,
+                        const SizeiPtr& size,
+                        const void* data,
+                        const Val<const SrcLoc>& src_loc);
+};
+
+// GPU-resident vector with CPU shadow. Writes mark dirty ranges which are
+// coalesced and flushed once per frame, growth is geometric.
 template<typename T>
-class Vector : public Buffer {
+class GlVector : public ContextObject<GlVector<T>>, public GlVectorStatic {
 public:
-    static sptr<Vector> make1(const sptr<Context>& ctx,
-                             const Val<const UInt>& size,
-                             const Val<const BufferUsage>& usage,
-                             const Val<const T>& initial,
-                             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        auto self = sptr<Vector>(new Vector(ctx, size, usage, initial, src_loc));
-        static const Val<T*> empty(nullptr);
-        self->data(self->_capacity * sizeof(T), empty, self->_usage);
-        for (UInt i = 0; i < self->_size; ++i){
-            self->set(i, initial, src_loc);
-        }
-        return self;
-    }
+    static std::shared_ptr<GlVector> make(const std::shared_ptr<Context>& ctx,
+                                          const Val<const UInt>& size = 0,
+                                          const Val<const T>& initial = T{},
+                                          const Val<const SrcLoc>& src_loc = SrcLoc{});
+    virtual ~GlVector(){};
+
+    // Any thread
+    UInt size() const;
+    UInt capacity() const;
+    T get(const UInt& i) const;
+    void set(const UInt& i, const T& value);
+    void reserve(const UInt& capacity);
+    void resize(const UInt& size, const T& value = T{});
+    void clear();
+    void pushBack(const T& value);
+    T popBack();
+
+    template<typename It>
+    void assign(It first, It last);
+    template<typename It>
+    void append(It first, It last);
+
+    // Valid until next growth, prefer bind* methods which resolve it on context thread
+    std::shared_ptr<GlBuffer> getBuffer() const;
+
+    // glBindBufferBase
+    void bindBase(const Val<const Enum>& target,
+                  const Val<const UInt>& index,
+                  const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // Uploads dirty ranges now instead of waiting for next frame
+    void flush(const Val<const SrcLoc>& src_loc = SrcLoc{});
 
-    ~Vector(){};
+protected:
+    GlVector(const std::shared_ptr<Context>& ctx,
+             const UInt& size,
+             const T& initial);
 
-    bool getSize(const Val<UInt>& dst,
-                 const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) const {
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::getSize, dst, src_loc);
-        }
+private:
+    // Ranges closer than this are uploaded with one call
+    static constexpr UInt _merge_gap = 64 / sizeof(T) + 1;
 
-        *dst = _size;
-        debug(src_loc);
-        return true;
-    }
+    mutable std::mutex _lock;
+    std::vector<T> _shadow;
+    UInt _capacity;
+    std::vector<std::pair<UInt, UInt>> _dirty;
+    std::shared_ptr<GlBuffer> _buffer;
+    UInt _gpu_capacity;
+    UInt _gpu_size;
+
+    // Should be called when mutex is locked
+    void _markDirty(const UInt& begin, const UInt& end);
+    void _ensureCapacity(const UInt& size);
+};
 
-    bool getCapacity(const Val<UInt>& dst,
-                     const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) const {
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::getCapacity, dst, src_loc);
+template<typename T>
+inline std::shared_ptr<GlVector<T>> GlVector<T>::make(const std::shared_ptr<Context>& ctx,
+                                                      const Val<const UInt>& size,
+                                                      const Val<const T>& initial,
+                                                      const Val<const SrcLoc>& src_loc){
+    auto self = std::shared_ptr<GlVector>(new GlVector(ctx, *size, *initial));
+    ctx->onRun->addActionQueued([wself = std::weak_ptr<GlVector>(self), src_loc](){
+        auto self = wself.lock();
+        if (!self){
+            return false;
         }
-
-        *dst = _capacity;
-        debug(src_loc);
+        self->flush(src_loc);
         return true;
-    }
+    });
+    return self;
+}
 
-    bool get(const Val<const UInt>& i, const Val<T>& dst,
-             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) const {
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::get, i, dst, src_loc);
-        }
+template<typename T>
+inline GlVector<T>::GlVector(const std::shared_ptr<Context>& ctx,
+                             const UInt& size,
+                             const T& initial) :
+    ContextObject<GlVector<T>>(ctx),
+    _shadow(size, initial),
+    _capacity(std::max<UInt>(size, 4)),
+    _gpu_capacity(0),
+    _gpu_size(0){
+    _shadow.reserve(_capacity);
+    _markDirty(0, size);
+}
 
-        if (*i >= _size){
-            throw std::out_of_range("glwpp::gl::Vector");
-        }
+template<typename T>
+inline UInt GlVector<T>::size() const {
+    std::lock_guard lg(_lock);
+    return static_cast<UInt>(_shadow.size());
+}
 
-        getSubData(dst, *i * sizeof(T), sizeof(T), src_loc);
-        debug(src_loc);
-        return true;
-    }
+template<typename T>
+inline UInt GlVector<T>::capacity() const {
+    std::lock_guard lg(_lock);
+    return _capacity;
+}
 
-    bool set(const Val<const UInt>& i, const Val<const T>& value,
-             const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::set, i, value, src_loc);
-        }
+template<typename T>
+inline T GlVector<T>::get(const UInt& i) const {
+    std::lock_guard lg(_lock);
+    return _shadow.at(i);
+}
 
-        if (*i >= _size){
-            throw std::out_of_range("glwpp::gl::Vector");
-        }
+template<typename T>
+inline void GlVector<T>::set(const UInt& i, const T& value){
+    std::lock_guard lg(_lock);
+    _shadow.at(i) = value;
+    _markDirty(i, i + 1);
+}
 
-        setSubData(value.cast_reinterpret<const void>(), *i * sizeof(T), sizeof(T), src_loc);
-        debug(src_loc);
-        return true;
+template<typename T>
+inline void GlVector<T>::reserve(const UInt& capacity){
+    std::lock_guard lg(_lock);
+    if (capacity > _capacity){
+        _capacity = capacity;
+        _shadow.reserve(_capacity);
     }
+}
 
-    bool reserve(const Val<const UInt>& capacity,
-                 const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::reserve, capacity, src_loc);
-        }
-
-        if (*capacity <= _capacity){
-            return true;
-        }
+template<typename T>
+inline void GlVector<T>::resize(const UInt& size, const T& value){
+    std::lock_guard lg(_lock);
+    UInt old_size = static_cast<UInt>(_shadow.size());
+    _ensureCapacity(size);
+    _shadow.resize(size, value);
+    if (size > old_size){
+        _markDirty(old_size, size);
+    }
+}
 
-        auto tmp = Buffer::make(getContext().lock(), src_loc);
-        tmp->data(_size * sizeof(T), Val<const void>(sptr<void>()), BufferUsage::StreamCopy, src_loc);
-        tmp->copySubData(std::static_pointer_cast<const Vector>(shared_from_this()), 0, 0, _size * sizeof(T), src_loc);
+template<typename T>
+inline void GlVector<T>::clear(){
+    std::lock_guard lg(_lock);
+    _shadow.clear();
+    _dirty.clear();
+}
 
-        _capacity = *capacity;
-        data(_capacity * sizeof(T), Val<const void>(sptr<void>()), _usage, src_loc);
-        copySubData(tmp, 0, 0, _size * sizeof(T), src_loc);
+template<typename T>
+inline void GlVector<T>::pushBack(const T& value){
+    std::lock_guard lg(_lock);
+    UInt i = static_cast<UInt>(_shadow.size());
+    _ensureCapacity(i + 1);
+    _shadow.push_back(value);
+    _markDirty(i, i + 1);
+}
 
-        debug(src_loc);
-        return true;
+template<typename T>
+inline T GlVector<T>::popBack(){
+    std::lock_guard lg(_lock);
+    if (_shadow.empty()){
+        throw std::out_of_range("nglpmt::native::GlVector");
     }
+    T value = _shadow.back();
+    _shadow.pop_back();
+    return value;
+}
 
-    bool shape(const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::shape, src_loc);
-        }
+template<typename T>
+template<typename It>
+inline void GlVector<T>::assign(It first, It last){
+    std::lock_guard lg(_lock);
+    _shadow.assign(first, last);
+    _ensureCapacity(static_cast<UInt>(_shadow.size()));
+    _dirty.clear();
+    _markDirty(0, static_cast<UInt>(_shadow.size()));
+}
 
-        auto tmp = Buffer::make(getContext().lock(), src_loc);
-        tmp->data(_size * sizeof(T), Val<const void>(sptr<void>()), BufferUsage::StreamCopy, src_loc);
-        tmp->copySubData(shared_from_this(), 0, 0, _size * sizeof(T), src_loc);
+template<typename T>
+template<typename It>
+inline void GlVector<T>::append(It first, It last){
+    std::lock_guard lg(_lock);
+    UInt begin = static_cast<UInt>(_shadow.size());
+    _shadow.insert(_shadow.end(), first, last);
+    _ensureCapacity(static_cast<UInt>(_shadow.size()));
+    _markDirty(begin, static_cast<UInt>(_shadow.size()));
+}
 
-        _capacity = _size;
-        data(_size * sizeof(T), Val<const void>(sptr<void>()), _usage, src_loc);
-        copySubData(tmp, 0, 0, _size * sizeof(T), src_loc);
+template<typename T>
+inline std::shared_ptr<GlBuffer> GlVector<T>::getBuffer() const {
+    std::lock_guard lg(_lock);
+    return _buffer;
+}
 
-        debug(src_loc);
-        return true;
+template<typename T>
+inline void GlVector<T>::bindBase(const Val<const Enum>& target,
+                                  const Val<const UInt>& index,
+                                  const Val<const SrcLoc>& src_loc) const {
+    if (this->template movedToContext<&GlVector::bindBase>(target, index, src_loc)){return;}
+    auto buffer = getBuffer();
+    if (buffer){
+        buffer->bindBase(target, index, src_loc);
     }
+}
 
-    bool pushBack(const Val<const std::optional<T>>& value,
-                  const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::pushBack, value, src_loc);
-        }
-
-        if (_size == _capacity){
-            reserve(2 * *_size, src_loc);
+template<typename T>
+inline void GlVector<T>::flush(const Val<const SrcLoc>& src_loc){
+    if (this->template movedToContext<&GlVector::flush>(src_loc)){return;}
+
+    std::lock_guard lg(_lock);
+    UInt size = static_cast<UInt>(_shadow.size());
+    if (_gpu_capacity < _capacity){
+        auto ctx = this->getContext().lock();
+        if (!ctx){
+            return;
         }
+        UInt valid = std::min(_gpu_size, size);
+        _buffer = _grow(ctx, _buffer, valid * sizeof(T), _capacity * sizeof(T), src_loc);
+        _gpu_capacity = _capacity;
+    }
+    _gpu_size = size;
 
-        set(_size, value, src_loc);
-        ++_size;
-        debug(src_loc);
-        return true;
+    if (_dirty.empty()){
+        return;
     }
 
-    bool popBack(const Val<T>& dst,
-                 const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}){
-        if (!isContextThread()){
-            return executeMethodInContext(&Vector::popBack, dst, src_loc);
+    std::sort(_dirty.begin(), _dirty.end());
+    UInt begin = _dirty.front().first;
+    UInt end = _dirty.front().second;
+    auto upload = [this, &src_loc, size](UInt begin, UInt end){
+        end = std::min(end, size);
+        if (begin < end){
+            _upload(_buffer, begin * sizeof(T), (end - begin) * sizeof(T), _shadow.data() + begin, src_loc);
         }
-
-        if (_size == 0){
-            throw std::out_of_range("glwpp::gl::Vector");
+    };
+    for (auto& range : _dirty){
+        if (range.first > end + _merge_gap){
+            upload(begin, end);
+            begin = range.first;
         }
-        
-        get(*_size - 1, dst, src_loc);
-        --_size;
-        debug(src_loc);
-        return true;
+        end = std::max(end, range.second);
     }
+    upload(begin, end);
+    _dirty.clear();
+}
 
-protected:
-    Vector(const sptr<Context>& ctx,
-           const Val<const UInt>& size,
-           const Val<const BufferUsage>& usage,
-           const Val<const T>& initial,
-           const Val<const utils::SrcLoc>& src_loc = utils::SrcLoc{}) :
-        Buffer(ctx, src_loc),
-        _size(size),
-        _capacity(*size < 4 ? 4 : *size),
-        _usage(usage){
+template<typename T>
+inline void GlVector<T>::_markDirty(const UInt& begin, const UInt& end){
+    if (begin >= end){
+        return;
     }
+    // Extend last range for sequential writes
+    if (!_dirty.empty() && _dirty.back().second + _merge_gap >= begin && _dirty.back().first <= end){
+        _dirty.back().first = std::min(_dirty.back().first, begin);
+        _dirty.back().second = std::max(_dirty.back().second, end);
+        return;
+    }
+    _dirty.emplace_back(begin, end);
+}
 
-private:
-    // Hide parent's make
-    using Buffer::make;
-
-    UInt _size;
-    UInt _capacity;
-    BufferUsage _usage;
-};
+template<typename T>
+inline void GlVector<T>::_ensureCapacity(const UInt& size){
+    if (size <= _capacity){
+        return;
+    }
+    _capacity = std::max(size, _capacity * 2);
+    _shadow.reserve(_capacity);
+}
 
-}
\ No newline at end of file
+} // namespace nglpmt::native
@@ -6,7 +6,7 @@ using namespace nglpmt::native;
 
 std::shared_ptr<GlVertexArray> GlVertexArray::make(const std::shared_ptr<Context>& ctx,
                                                const Val<const SrcLoc>& src_loc){
-    std::shared_ptr<GlVertexArray>(new GlVertexArray(ctx, src_loc));
+    return std::shared_ptr<GlVertexArray>(new GlVertexArray(ctx, src_loc));
 }
 
 GlVertexArray::GlVertexArray(const std::shared_ptr<Context>& ctx, const Val<const SrcLoc>& src_loc) :
@@ -123,6 +123,16 @@ void GlVertexArray::setAttribFormat(const Val<const UInt>& attribindex,
     debug(src_loc);
 }
 
+void GlVertexArray::setAttribIFormat(const Val<const UInt>& attribindex,
+                                     const Val<const Int>& size,
+                                     const Val<const Enum>& type,
+                                     const Val<const UInt>& relativeOffset,
+                                     const Val<const SrcLoc>& src_loc){
+    if (movedToContext<&GlVertexArray::setAttribIFormat>(attribindex, size, type, relativeOffset, src_loc)){return;}
+    glVertexArrayAttribIFormat(id(), attribindex, size, type, relativeOffset);
+    debug(src_loc);
+}
+
 void GlVertexArray::setBindingDivisor(const Val<const UInt>& bindingindex,
                                       const Val<const UInt>& divisor, 
                                       const Val<const SrcLoc>& src_loc){
@@ -148,6 +158,12 @@ void GlVertexArray::setVertexBuffer(const Val<const UInt>& bindingindex,
     debug(src_loc);
 }
 
+void GlVertexArray::bind(const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlVertexArray::bind>(src_loc)){return;}
+    glBindVertexArray(id());
+    debug(src_loc);
+}
+
 void GlVertexArray::drawInstanced(const Val<const Enum>& mode,
                                   const Val<const Sizei>& count,
                                   const Val<const Enum>& type,
@@ -160,6 +176,65 @@ void GlVertexArray::drawInstanced(const Val<const Enum>& mode,
     debug(src_loc);
 }
 
+void GlVertexArray::drawElements(const Val<const Enum>& mode,
+                                 const Val<const Sizei>& count,
+                                 const Val<const Enum>& type,
+                                 const Val<const IntPtr>& offset,
+                                 const Val<const Sizei>& instances,
+                                 const Val<const Int>& base_vertex,
+                                 const Val<const UInt>& base_instance,
+                                 const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlVertexArray::drawElements>(mode, count, type, offset, instances, base_vertex, base_instance, src_loc)){return;}
+    glBindVertexArray(id());
+    glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, reinterpret_cast<const void*>(*offset), instances, base_vertex, base_instance);
+    glBindVertexArray(0);
+    debug(src_loc);
+}
+
+void GlVertexArray::drawArrays(const Val<const Enum>& mode,
+                               const Val<const Int>& first,
+                               const Val<const Sizei>& count,
+                               const Val<const Sizei>& instances,
+                               const Val<const UInt>& base_instance,
+                               const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlVertexArray::drawArrays>(mode, first, count, instances, base_instance, src_loc)){return;}
+    glBindVertexArray(id());
+    glDrawArraysInstancedBaseInstance(mode, first, count, instances, base_instance);
+    glBindVertexArray(0);
+    debug(src_loc);
+}
+
+void GlVertexArray::multiDrawElementsIndirect(const Val<const Enum>& mode,
+                                              const Val<const Enum>& type,
+                                              const Val<const GlBuffer>& indirect,
+                                              const Val<const IntPtr>& offset,
+                                              const Val<const Sizei>& drawcount,
+                                              const Val<const Sizei>& stride,
+                                              const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlVertexArray::multiDrawElementsIndirect>(mode, type, indirect, offset, drawcount, stride, src_loc)){return;}
+    glBindVertexArray(id());
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect->id());
+    glMultiDrawElementsIndirect(mode, type, reinterpret_cast<const void*>(*offset), drawcount, stride);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+    debug(src_loc);
+}
+
+void GlVertexArray::multiDrawArraysIndirect(const Val<const Enum>& mode,
+                                            const Val<const GlBuffer>& indirect,
+                                            const Val<const IntPtr>& offset,
+                                            const Val<const Sizei>& drawcount,
+                                            const Val<const Sizei>& stride,
+                                            const Val<const SrcLoc>& src_loc) const {
+    if (movedToContext<&GlVertexArray::multiDrawArraysIndirect>(mode, indirect, offset, drawcount, stride, src_loc)){return;}
+    glBindVertexArray(id());
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect->id());
+    glMultiDrawArraysIndirect(mode, reinterpret_cast<const void*>(*offset), drawcount, stride);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+    debug(src_loc);
+}
+
 void GlVertexArray::_initer(const Val<UInt>& dst, const Val<const SrcLoc>& src_loc){
     glCreateVertexArrays(1, dst);
 }
@@ -82,6 +82,13 @@ public:
                          const Val<const UInt>& relativeOffset, 
                          const Val<const SrcLoc>& src_loc = SrcLoc{});
 
+    // glVertexArrayAttribIFormat
+    void setAttribIFormat(const Val<const UInt>& attribindex,
+                          const Val<const Int>& size,
+                          const Val<const Enum>& type,
+                          const Val<const UInt>& relativeOffset,
+                          const Val<const SrcLoc>& src_loc = SrcLoc{});
+
     // glVertexArrayBindingDivisor
     void setBindingDivisor(const Val<const UInt>& bindingindex,
                            const Val<const UInt>& divisor, 
@@ -98,12 +105,50 @@ public:
                          const Val<const Sizei>& stride, 
                          const Val<const SrcLoc>& src_loc = SrcLoc{});
 
+    // glBindVertexArray
+    void bind(const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
     // glDrawElementsInstanced
     void drawInstanced(const Val<const Enum>& mode,
                        const Val<const Sizei>& count,
                        const Val<const Enum>& type,
                        const Val<const Sizei>& instances, 
                        const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glDrawElementsInstancedBaseVertexBaseInstance, offset is in bytes of element buffer
+    void drawElements(const Val<const Enum>& mode,
+                      const Val<const Sizei>& count,
+                      const Val<const Enum>& type,
+                      const Val<const IntPtr>& offset,
+                      const Val<const Sizei>& instances = 1,
+                      const Val<const Int>& base_vertex = 0,
+                      const Val<const UInt>& base_instance = 0,
+                      const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glDrawArraysInstancedBaseInstance
+    void drawArrays(const Val<const Enum>& mode,
+                    const Val<const Int>& first,
+                    const Val<const Sizei>& count,
+                    const Val<const Sizei>& instances = 1,
+                    const Val<const UInt>& base_instance = 0,
+                    const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glMultiDrawElementsIndirect, commands are read from indirect buffer at offset
+    void multiDrawElementsIndirect(const Val<const Enum>& mode,
+                                   const Val<const Enum>& type,
+                                   const Val<const GlBuffer>& indirect,
+                                   const Val<const IntPtr>& offset,
+                                   const Val<const Sizei>& drawcount,
+                                   const Val<const Sizei>& stride = 0,
+                                   const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
+
+    // glMultiDrawArraysIndirect
+    void multiDrawArraysIndirect(const Val<const Enum>& mode,
+                                 const Val<const GlBuffer>& indirect,
+                                 const Val<const IntPtr>& offset,
+                                 const Val<const Sizei>& drawcount,
+                                 const Val<const Sizei>& stride = 0,
+                                 const Val<const SrcLoc>& src_loc = SrcLoc{}) const;
 protected:
     GlVertexArray(const std::shared_ptr<Context>& ctx,
                 const Val<const SrcLoc>& src_loc = SrcLoc{});
@@ -0,0 +1,95 @@
+#include "native/gl/VertexLayout.hpp"
+
+#include <algorithm>
+
+using namespace nglpmt::native;
+
+namespace {
+    size_t combine(size_t seed, size_t value){
+        return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+}
+
+void GlVertexLayout::normalize(){
+    std::sort(attribs.begin(), attribs.end());
+    std::sort(bindings.begin(), bindings.end());
+}
+
+size_t GlVertexLayout::Hash::operator()(const GlVertexLayout& layout) const {
+    size_t seed = layout.attribs.size();
+    for (auto& attrib : layout.attribs){
+        seed = combine(seed, attrib.index);
+        seed = combine(seed, attrib.size);
+        seed = combine(seed, attrib.type);
+        seed = combine(seed, (attrib.normalized ? 1 : 0) | (attrib.integer ? 2 : 0));
+        seed = combine(seed, attrib.relative_offset);
+        seed = combine(seed, attrib.binding);
+    }
+    for (auto& binding : layout.bindings){
+        seed = combine(seed, binding.index);
+        seed = combine(seed, binding.divisor);
+    }
+    return seed;
+}
+
+std::shared_ptr<GlVertexLayoutCache> GlVertexLayoutCache::make(const std::shared_ptr<Context>& ctx){
+    return std::shared_ptr<GlVertexLayoutCache>(new GlVertexLayoutCache(ctx));
+}
+
+GlVertexLayoutCache::GlVertexLayoutCache(const std::shared_ptr<Context>& ctx) :
+    _wctx(ctx){
+}
+
+GlVertexLayoutCache::~GlVertexLayoutCache(){
+}
+
+std::shared_ptr<GlVertexArray> GlVertexLayoutCache::get(const GlVertexLayout& layout,
+                                                        const Val<const SrcLoc>& src_loc){
+    auto key = layout;
+    key.normalize();
+
+    std::lock_guard lg(_lock);
+    auto iter = _arrays.find(key);
+    if (iter != _arrays.end()){
+        return iter->second;
+    }
+
+    auto ctx = _wctx.lock();
+    if (!ctx){
+        throw std::runtime_error("Context is destroyed");
+    }
+
+    auto vao = GlVertexArray::make(ctx, src_loc);
+    if (vao->isContextThread()){
+        _configure(vao, key, src_loc);
+    } else {
+        ctx->onRun->addActionQueued([vao, key, src_loc](){
+            _configure(vao, key, src_loc);
+            return false;
+        });
+    }
+    _arrays.emplace(std::move(key), vao);
+    return vao;
+}
+
+size_t GlVertexLayoutCache::getSize() const {
+    std::lock_guard lg(_lock);
+    return _arrays.size();
+}
+
+void GlVertexLayoutCache::_configure(const std::shared_ptr<GlVertexArray>& vao,
+                                     const GlVertexLayout& layout,
+                                     const Val<const SrcLoc>& src_loc){
+    for (auto& attrib : layout.attribs){
+        vao->enableAttrib(attrib.index, src_loc);
+        if (attrib.integer){
+            vao->setAttribIFormat(attrib.index, attrib.size, attrib.type, attrib.relative_offset, src_loc);
+        } else {
+            vao->setAttribFormat(attrib.index, attrib.size, attrib.type, attrib.normalized, attrib.relative_offset, src_loc);
+        }
+        vao->setAttribBinding(attrib.index, attrib.binding, src_loc);
+    }
+    for (auto& binding : layout.bindings){
+        vao->setBindingDivisor(binding.index, binding.divisor, src_loc);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "native/gl/VertexArray.hpp"
+
+namespace nglpmt::native {
+
+struct GlVertexAttrib {
+    UInt index;
+    Int size;
+    Enum type;
+    bool normalized = false;
+    // Uses glVertexArrayAttribIFormat
+    bool integer = false;
+    UInt relative_offset = 0;
+    UInt binding = 0;
+
+    auto operator<=>(const GlVertexAttrib&) const = default;
+};
+
+struct GlVertexBinding {
+    UInt index;
+    UInt divisor = 0;
+
+    auto operator<=>(const GlVertexBinding&) const = default;
+};
+
+// Vertex format without buffers, buffers are set per draw
+struct GlVertexLayout {
+    std::vector<GlVertexAttrib> attribs;
+    std::vector<GlVertexBinding> bindings;
+
+    bool operator==(const GlVertexLayout&) const = default;
+
+    // Sorts by index, equal layouts declared in another order compare equal
+    void normalize();
+
+    struct Hash {
+        size_t operator()(const GlVertexLayout& layout) const;
+    };
+};
+
+// Hands out one configured vertex array per unique layout. Whole format is
+// set up with one context command when layout is seen first time.
+class GlVertexLayoutCache : public SharedObject<GlVertexLayoutCache> {
+public:
+    static std::shared_ptr<GlVertexLayoutCache> make(const std::shared_ptr<Context>& ctx);
+    virtual ~GlVertexLayoutCache();
+
+    // Any thread
+    std::shared_ptr<GlVertexArray> get(const GlVertexLayout& layout,
+                                       const Val<const SrcLoc>& src_loc = SrcLoc{});
+
+    size_t getSize() const;
+
+protected:
+    GlVertexLayoutCache(const std::shared_ptr<Context>& ctx);
+
+private:
+    const std::weak_ptr<Context> _wctx;
+
+    mutable std::mutex _lock;
+    std::unordered_map<GlVertexLayout, std::shared_ptr<GlVertexArray>, GlVertexLayout::Hash> _arrays;
+
+    // context thread
+    static void _configure(const std::shared_ptr<GlVertexArray>& vao,
+                           const GlVertexLayout& layout,
+                           const Val<const SrcLoc>& src_loc);
+};
+
+} // namespace nglpmt::native
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace nglpmt::native {
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+// Capacity is rounded up to power of two, push fails when ring is full.
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(const size_t& capacity);
+    SpscRing(const SpscRing&) = delete;
+    SpscRing(const SpscRing&&) = delete;
+
+    // Producer thread
+    bool push(const T& value);
+    // Consumer thread
+    bool pop(T& dst);
+
+    size_t capacity() const;
+    // Approximate from any other thread
+    size_t size() const;
+
+private:
+    // Producer and consumer indices live on different cache lines
+    static constexpr size_t _cache_line = 64;
+
+    std::vector<T> _data;
+    const size_t _mask;
+    alignas(_cache_line) std::atomic<size_t> _head;
+    alignas(_cache_line) std::atomic<size_t> _tail;
+
+    static size_t _roundUp(const size_t& capacity);
+};
+
+
+
+
+
+template<typename T>
+inline SpscRing<T>::SpscRing(const size_t& capacity) :
+    _data(_roundUp(capacity)),
+    _mask(_data.size() - 1),
+    _head(0),
+    _tail(0){
+}
+
+template<typename T>
+inline bool SpscRing<T>::push(const T& value){
+    auto head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == _data.size()){
+        return false;
+    }
+    _data[head & _mask] = value;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline bool SpscRing<T>::pop(T& dst){
+    auto tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)){
+        return false;
+    }
+    dst = _data[tail & _mask];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline size_t SpscRing<T>::capacity() const {
+    return _data.size();
+}
+
+template<typename T>
+inline size_t SpscRing<T>::size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+}
+
+template<typename T>
+inline size_t SpscRing<T>::_roundUp(const size_t& capacity){
+    size_t size = 1;
+    while (size < capacity){
+        size <<= 1;
+    }
+    return size;
+}
+
+} // namespace nglpmt::native
\ No newline at end of file
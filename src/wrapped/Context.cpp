@@ -11,16 +11,41 @@ Napi::Function Context::getJsConstructor(Napi::Env env) {
     return DefineClass(env, "Context", {
         InstanceMethod<&Context::release>("release", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
         InstanceMethod<&Context::run>("run", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::start>("start", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::stop>("stop", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::getFrameTimings>("getFrameTimings", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
         InstanceMethod<&Context::onRun>("onRun", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
 
         InstanceMethod<&Context::onKeyAdd>("onKeyAdd", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
         InstanceMethod<&Context::onKeyRemove>("onKeyRemove", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
         InstanceMethod<&Context::onKeyClear>("onKeyClear", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+
+        InstanceMethod<&Context::onFrameAdd>("onFrameAdd", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::onFrameRemove>("onFrameRemove", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::onFrameClear>("onFrameClear", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+
+        InstanceMethod<&Context::onInputAdd>("onInputAdd", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::onInputRemove>("onInputRemove", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&Context::onInputClear>("onInputClear", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
     });
 }
 
 namespace {
-    static const native::Context::Parameters default_params{.title = "Context", .width = 640, .height = 480};
+    static const native::Context::Parameters default_params{.title = "Context", .width = 640, .height = 480, .fps = 60};
+    // Optional second constructor argument: {headless: boolean, loaderThreads: number}
+    static native::Context::Parameters getParams(const Napi::CallbackInfo& info){
+        auto params = default_params;
+        if (info.Length() > 1 && info[1].IsObject()){
+            auto options = info[1].As<Napi::Object>();
+            if (options.Has("headless")){
+                params.headless = options.Get("headless").ToBoolean();
+            }
+            if (options.Has("loaderThreads")){
+                params.loader_threads = options.Get("loaderThreads").ToNumber().Uint32Value();
+            }
+        }
+        return params;
+    }
     static std::vector<Napi::Value> onKeyConvert(Napi::Env env,
                                                  const std::tuple<const std::shared_ptr<native::Context>, const int, const int, const int, const int> args){
         auto key = Napi::BigInt::New(env, static_cast<int64_t>(std::get<1>(args)));
@@ -29,12 +54,115 @@ namespace {
         auto mods = Napi::BigInt::New(env, static_cast<int64_t>(std::get<4>(args)));
         return std::vector<Napi::Value>{key, scancode, action, mods};
     }
+    static std::vector<Napi::Value> onFrameConvert(Napi::Env env,
+                                                   const std::tuple<const std::shared_ptr<native::Context>, const uint64_t, const double> args){
+        auto index = Napi::BigInt::New(env, std::get<1>(args));
+        auto dt = Napi::Number::New(env, std::get<2>(args));
+        return std::vector<Napi::Value>{index, dt};
+    }
+    static Napi::Object inputEventConvert(Napi::Env env, const native::InputEvent& event){
+        using Type = native::InputEvent::Type;
+        auto obj = Napi::Object::New(env);
+        auto set = [&obj, env](const char* name, double value){
+            obj.Set(name, Napi::Number::New(env, value));
+        };
+        switch (event.type){
+        case Type::WindowMove:
+            obj.Set("type", "windowMove");
+            set("x", event.args[0]);
+            set("y", event.args[1]);
+            break;
+        case Type::WindowResize:
+            obj.Set("type", "windowResize");
+            set("width", event.args[0]);
+            set("height", event.args[1]);
+            break;
+        case Type::WindowClose:
+            obj.Set("type", "windowClose");
+            break;
+        case Type::WindowRefresh:
+            obj.Set("type", "windowRefresh");
+            break;
+        case Type::WindowFocus:
+            obj.Set("type", "windowFocus");
+            obj.Set("focused", Napi::Boolean::New(env, event.args[0]));
+            break;
+        case Type::WindowIconify:
+            obj.Set("type", "windowIconify");
+            obj.Set("iconified", Napi::Boolean::New(env, event.args[0]));
+            break;
+        case Type::WindowMaximize:
+            obj.Set("type", "windowMaximize");
+            obj.Set("maximized", Napi::Boolean::New(env, event.args[0]));
+            break;
+        case Type::WindowScale:
+            obj.Set("type", "windowScale");
+            set("x", event.values[0]);
+            set("y", event.values[1]);
+            break;
+        case Type::FramebufferResize:
+            obj.Set("type", "framebufferResize");
+            set("width", event.args[0]);
+            set("height", event.args[1]);
+            break;
+        case Type::CursorEnter:
+            obj.Set("type", "cursorEnter");
+            obj.Set("entered", Napi::Boolean::New(env, event.args[0]));
+            break;
+        case Type::CursorMove:
+            obj.Set("type", "cursorMove");
+            set("x", event.values[0]);
+            set("y", event.values[1]);
+            set("dx", event.values[2]);
+            set("dy", event.values[3]);
+            break;
+        case Type::CursorButton:
+            obj.Set("type", "cursorButton");
+            set("button", event.args[0]);
+            set("action", event.args[1]);
+            set("mods", event.args[2]);
+            break;
+        case Type::CursorScroll:
+            obj.Set("type", "cursorScroll");
+            set("x", event.values[0]);
+            set("y", event.values[1]);
+            break;
+        case Type::Key:
+            obj.Set("type", "key");
+            set("key", event.args[0]);
+            set("scancode", event.args[1]);
+            set("action", event.args[2]);
+            set("mods", event.args[3]);
+            break;
+        case Type::Char:
+            obj.Set("type", "char");
+            set("codepoint", event.args[0]);
+            break;
+        }
+        return obj;
+    }
+    static std::vector<Napi::Value> onInputConvert(Napi::Env env,
+                                                   const std::tuple<const std::shared_ptr<native::Context>, const std::shared_ptr<native::InputBatch>> args){
+        auto& batch = *std::get<1>(args);
+        auto events = Napi::Array::New(env, batch.events.size());
+        for (size_t i = 0; i < batch.events.size(); ++i){
+            events.Set(static_cast<uint32_t>(i), inputEventConvert(env, batch.events[i]));
+        }
+        auto obj = Napi::Object::New(env);
+        obj.Set("events", events);
+        obj.Set("cursorDx", Napi::Number::New(env, batch.cursor_dx));
+        obj.Set("cursorDy", Napi::Number::New(env, batch.cursor_dy));
+        obj.Set("dropped", Napi::Number::New(env, static_cast<double>(batch.dropped)));
+        return std::vector<Napi::Value>{obj};
+    }
 }
 
 Context::Context(const Napi::CallbackInfo& info) :
     Napi::ObjectWrap<Context>(info),
-    _native(_getMap().getOrMake(info[0].As<Napi::String>(), &native::Context::make, default_params)),
-    _on_key(_native->onKey, &onKeyConvert){
+    _native(_getMap().getOrMake(info[0].As<Napi::String>(), &native::Context::make, getParams(info))),
+    _on_key(_native->onKey, &onKeyConvert),
+    _on_frame(_native->onFrame, &onFrameConvert),
+    _on_input(_native->onInput, &onInputConvert){
 }
 
 Context::~Context(){
@@ -44,8 +172,16 @@ std::shared_ptr<native::Context> Context::getNative(){
     return _native;
 }
 
+std::shared_ptr<native::GlReadback> Context::getReadback(){
+    if (!_readback && _native){
+        _readback = native::GlReadback::make(_native);
+    }
+    return _readback;
+}
+
 Napi::Value Context::release(const Napi::CallbackInfo& info){
     std::cout << __FUNCTION__ << std::endl;
+    _readback.reset();
     _native.reset();
     // _on_run.reset();
     std::cout << __FUNCTION__ << std::endl;
@@ -57,16 +193,51 @@ Napi::Value Context::run(const Napi::CallbackInfo& info){
     auto resolve = Napi::Function::New(info.Env(), [deffered](const Napi::CallbackInfo& info){deffered.Resolve(deffered.Env().Null());});
     auto tsfn = Napi::TypedThreadSafeFunction<>::New(info.Env(), resolve, __FUNCTION__, 0, 1);
 
-    _native->onFinish->addActionQueued([tsfn](){
+    if (_native->isStarted()){
+        tsfn.Release();
+        throw Napi::Error::New(info.Env(), "Context.run() is not allowed after start()");
+    }
+    // Next frame may be recorded while previous frames are in flight
+    _native->run([tsfn]() mutable {
         tsfn.NonBlockingCall();
         tsfn.Release();
-        return false;
     });
-    _native->run();
 
     return deffered.Promise();
 }
 
+Napi::Value Context::start(const Napi::CallbackInfo& info){
+    _native->start();
+    return info.Env().Null();
+}
+
+Napi::Value Context::stop(const Napi::CallbackInfo& info){
+    _native->stop();
+    return info.Env().Null();
+}
+
+Napi::Value Context::getFrameTimings(const Napi::CallbackInfo& info){
+    auto env = info.Env();
+    auto ms = [env](const native::Context::us& time){
+        return Napi::Number::New(env, std::chrono::duration<double, std::milli>(time).count());
+    };
+
+    auto timings = _native->getFrameTimings();
+    auto result = Napi::Array::New(env, timings.size());
+    for (size_t i = 0; i < timings.size(); ++i){
+        auto& timing = timings[i];
+        auto obj = Napi::Object::New(env);
+        obj.Set("index", Napi::BigInt::New(env, timing.index));
+        obj.Set("start", ms(timing.start));
+        obj.Set("run", ms(timing.run));
+        obj.Set("finish", ms(timing.finish));
+        obj.Set("swap", ms(timing.swap));
+        obj.Set("gpu", timing.gpu.count() < 0 ? env.Null() : ms(timing.gpu));
+        result.Set(static_cast<uint32_t>(i), obj);
+    }
+    return result;
+}
+
 Napi::Value Context::onRun(const Napi::CallbackInfo& info){
     // return _on_run.addAction(info);
     return info.Env().Null();
@@ -84,6 +255,30 @@ Napi::Value Context::onKeyClear(const Napi::CallbackInfo& info){
     return _on_key.clear(info);
 }
 
+Napi::Value Context::onFrameAdd(const Napi::CallbackInfo& info){
+    return _on_frame.addAction(info);
+}
+
+Napi::Value Context::onFrameRemove(const Napi::CallbackInfo& info){
+    return _on_frame.removeAction(info);
+}
+
+Napi::Value Context::onFrameClear(const Napi::CallbackInfo& info){
+    return _on_frame.clear(info);
+}
+
+Napi::Value Context::onInputAdd(const Napi::CallbackInfo& info){
+    return _on_input.addAction(info);
+}
+
+Napi::Value Context::onInputRemove(const Napi::CallbackInfo& info){
+    return _on_input.removeAction(info);
+}
+
+Napi::Value Context::onInputClear(const Napi::CallbackInfo& info){
+    return _on_input.clear(info);
+}
+
 MapMT<std::u16string, native::Context>& Context::_getMap(){
     static MapMT<std::u16string, native::Context> map;
     return map;
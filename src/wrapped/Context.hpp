@@ -6,6 +6,7 @@
 #include "napi.h"
 
 #include "native/Context.hpp"
+#include "native/gl/Readback.hpp"
 #include "wrapped/utils/MapMT.hpp"
 #include "wrapped/utils/NativeEvent.hpp"
 
@@ -19,22 +20,38 @@ public:
     ~Context();
 
     std::shared_ptr<native::Context> getNative();
+    // Shared by every object of this context, made on first use
+    std::shared_ptr<native::GlReadback> getReadback();
 
     Napi::Value release(const Napi::CallbackInfo& info);
     Napi::Value run(const Napi::CallbackInfo& info);
+    Napi::Value start(const Napi::CallbackInfo& info);
+    Napi::Value stop(const Napi::CallbackInfo& info);
+    Napi::Value getFrameTimings(const Napi::CallbackInfo& info);
 
     Napi::Value onRun(const Napi::CallbackInfo& info);
 
     Napi::Value onKeyAdd(const Napi::CallbackInfo& info);
     Napi::Value onKeyRemove(const Napi::CallbackInfo& info);
     Napi::Value onKeyClear(const Napi::CallbackInfo& info);
+
+    Napi::Value onFrameAdd(const Napi::CallbackInfo& info);
+    Napi::Value onFrameRemove(const Napi::CallbackInfo& info);
+    Napi::Value onFrameClear(const Napi::CallbackInfo& info);
+
+    Napi::Value onInputAdd(const Napi::CallbackInfo& info);
+    Napi::Value onInputRemove(const Napi::CallbackInfo& info);
+    Napi::Value onInputClear(const Napi::CallbackInfo& info);
     
 
 private:
     std::string _name;
     std::shared_ptr<native::Context> _native;
+    std::shared_ptr<native::GlReadback> _readback;
     // EventWrapped<std::weak_ptr<native::Context>, const std::chrono::milliseconds&> _on_run;
     EventWrapped<const std::shared_ptr<native::Context>, const int, const int, const int, const int> _on_key;
+    EventWrapped<const std::shared_ptr<native::Context>, const uint64_t, const double> _on_frame;
+    EventWrapped<const std::shared_ptr<native::Context>, const std::shared_ptr<native::InputBatch>> _on_input;
     
     static MapMT<std::u16string, native::Context>& _getMap(); 
 
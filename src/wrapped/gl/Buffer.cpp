@@ -16,12 +16,14 @@ Napi::Function GlBuffer::getJsConstructor(Napi::Env env) {
     return DefineClass(env, "GlBuffer", {
         InstanceMethod<&GlBuffer::data>("data", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
         InstanceMethod<&GlBuffer::getUsage>("getUsage", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+        InstanceMethod<&GlBuffer::getSubDataAsync>("getSubDataAsync", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
     });
 }
 
 GlBuffer::GlBuffer(const Napi::CallbackInfo& info) :
     Napi::ObjectWrap<GlBuffer>(info),
-    _native(native::GlBuffer::make(Context::Unwrap(info[0].As<Napi::Object>())->getNative())){
+    _native(native::GlBuffer::make(Context::Unwrap(info[0].As<Napi::Object>())->getNative())),
+    _readback(Context::Unwrap(info[0].As<Napi::Object>())->getReadback()){
 }
 
 GlBuffer::~GlBuffer(){
@@ -105,4 +107,42 @@ Napi::Value GlBuffer::getUsage(const Napi::CallbackInfo& info){
     _native->getUsage(dst);
 
     return GlVal<native::Enum>::jsCreate(info.Env(), dst);;
+}
+
+Napi::Value GlBuffer::getSubDataAsync(const Napi::CallbackInfo& info){
+    auto env = info.Env();
+    native::IntPtr offset = info[0].As<Napi::Number>().Int64Value();
+    native::SizeiPtr size = info[1].As<Napi::Number>().Int64Value();
+
+    if (!_native->getContext().lock()){
+        Napi::Error::New(env, "Context is destroyed").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    auto deffered = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function(), __FUNCTION__, 0, 1);
+
+    // Promise settles when the last copy of callback is destroyed, so tsfn
+    // gets released even if the read is dropped without calling back
+    auto result = std::shared_ptr<native::GlReadback::Data>(new native::GlReadback::Data(),
+                                                             [deffered, tsfn](native::GlReadback::Data* result) mutable {
+        tsfn.NonBlockingCall([deffered, data = *result](Napi::Env env, Napi::Function){
+            if (!data){
+                deffered.Reject(Napi::Error::New(env, "Readback was dropped").Value());
+                return;
+            }
+            auto array = Napi::ArrayBuffer::New(env, data->size());
+            memcpy(array.Data(), data->data(), data->size());
+            deffered.Resolve(array);
+        });
+        tsfn.Release();
+        delete result;
+    });
+
+    const native::GlReadback::Callback callback = [result](const native::GlReadback::Data& data){
+        *result = data;
+    };
+    _readback->readBuffer(std::static_pointer_cast<const native::GlBuffer>(_native), offset, size, callback);
+
+    return deffered.Promise();
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "napi.h"
 
 #include "native/gl/Buffer.hpp"
+#include "native/gl/Readback.hpp"
 
 namespace nglpmt::js {
     
@@ -16,9 +17,11 @@ public:
     Napi::Value data(const Napi::CallbackInfo& info);
     Napi::Value storage(const Napi::CallbackInfo& info);
     Napi::Value getUsage(const Napi::CallbackInfo& info);
+    Napi::Value getSubDataAsync(const Napi::CallbackInfo& info);
 
 private:
     std::shared_ptr<native::GlBuffer> _native;
+    std::shared_ptr<native::GlReadback> _readback;
 };
 
 } // namespace nglpmt::js
\ No newline at end of file